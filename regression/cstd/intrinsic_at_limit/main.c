@@ -0,0 +1,16 @@
+#include <assert.h>
+#include <string.h>
+
+/* The longest copy, compare and string handled without the loops of the
+ * operational models: 4096 bytes */
+#define N 4096
+
+int main()
+{
+  char src[N], dst[N + 1];
+  memcpy(dst + 1, src, N);
+  assert(memcmp(dst + 1, src, N) == 0);
+
+  src[N - 1] = 0;
+  assert(strlen(src) < N);
+}
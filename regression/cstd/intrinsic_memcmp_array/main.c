@@ -0,0 +1,16 @@
+#include <assert.h>
+#include <string.h>
+
+int main()
+{
+  unsigned char a[4] = {1, 2, 200, 4};
+  unsigned char b[4] = {1, 2, 3, 9};
+  assert(memcmp(a, b, 2) == 0);
+  assert(memcmp(a, b, 3) == 197);
+  assert(memcmp(b, a, 4) < 0);
+  assert(memcmp(a + 3, b + 3, 1) == -5);
+
+  unsigned char c[4];
+  if (memcmp(a, c, 4) == 0)
+    assert(c[2] == 200);
+}
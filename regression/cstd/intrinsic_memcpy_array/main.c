@@ -0,0 +1,29 @@
+#include <assert.h>
+#include <string.h>
+
+#define N 8
+
+int main()
+{
+  char src[N], dst[N];
+  for (int i = 0; i < N; i++)
+    dst[i] = 0;
+
+  memcpy(dst + 2, src + 1, 4);
+  assert(dst[0] == 0 && dst[1] == 0);
+  for (int i = 0; i < 4; i++)
+    assert(dst[i + 2] == src[i + 1]);
+  assert(dst[6] == 0 && dst[7] == 0);
+
+  // Overlapping, reads every byte before writing
+  char buf[N] = {1, 2, 3, 4, 5, 6, 7, 8};
+  memmove(buf + 1, buf, 6);
+  assert(buf[0] == 1 && buf[1] == 1 && buf[6] == 6 && buf[7] == 8);
+  memmove(buf, buf + 2, 5);
+  assert(buf[0] == 2 && buf[4] == 6);
+
+  char whole[N];
+  assert(memcpy(whole, src, N) == whole);
+  for (int i = 0; i < N; i++)
+    assert(whole[i] == src[i]);
+}
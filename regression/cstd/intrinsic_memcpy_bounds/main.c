@@ -0,0 +1,7 @@
+#include <string.h>
+
+int main()
+{
+  char src[8], dst[4];
+  memcpy(dst, src, 6);
+}
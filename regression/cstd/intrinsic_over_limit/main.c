@@ -0,0 +1,11 @@
+#include <string.h>
+
+/* One byte more than the intrinsics handle: the copy falls back to the loop
+ * of the operational model */
+#define N 4097
+
+int main()
+{
+  char src[N], dst[N + 1];
+  memcpy(dst + 1, src, N);
+}
@@ -0,0 +1,14 @@
+#include <assert.h>
+#include <string.h>
+
+int main()
+{
+  char s[6] = "abc";
+  assert(strlen(s) == 3);
+  assert(strlen(s + 1) == 2);
+  assert(strlen(s + 3) == 0);
+
+  char t[4];
+  t[3] = 0;
+  assert(strlen(t) <= 3);
+}
@@ -0,0 +1,7 @@
+#include <string.h>
+
+int main()
+{
+  char s[4] = {'a', 'b', 'c', 'd'};
+  return strlen(s);
+}
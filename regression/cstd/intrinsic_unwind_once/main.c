@@ -0,0 +1,21 @@
+#include <assert.h>
+#include <string.h>
+
+#define N 64
+
+/* The intrinsics replace the loops of the operational models, so a single
+ * unwinding is enough */
+int main()
+{
+  char src[N], dst[N];
+  memcpy(dst, src + 1, N - 1);
+  assert(dst[N - 2] == src[N - 1]);
+
+  memmove(dst + 1, dst, N - 1);
+  assert(dst[N - 1] == src[N - 1]);
+
+  assert(memcmp(dst + 1, src + 1, N - 2) == 0);
+
+  char s[N] = "intrinsic";
+  assert(strlen(s) == 9);
+}
@@ -0,0 +1,11 @@
+#include <assert.h>
+
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  if (x > 0 && x < 10)
+    assert(x * 2 < 18);
+  return 0;
+}
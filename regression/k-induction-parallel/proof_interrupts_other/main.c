@@ -0,0 +1,12 @@
+#include <assert.h>
+
+int main()
+{
+  /* The loop invariant is not inductive, so only the forward condition can
+   * prove this program, at a k greater than 1. The inductive step is still
+   * running when the proof is found and gets interrupted. */
+  int i, sn = 0;
+  for (i = 1; i <= 6; i++)
+    sn = sn + 2;
+  assert(sn == 12 || sn == 0);
+}
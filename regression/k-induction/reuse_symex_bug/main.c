@@ -0,0 +1,10 @@
+#include <assert.h>
+
+int main()
+{
+  int sum = 0;
+  for (int i = 0; i < 5; i++)
+    sum += i;
+  assert(sum == 15);
+  return 0;
+}
@@ -0,0 +1,11 @@
+extern int counter;
+
+int add(int a, int b)
+{
+  return a + b;
+}
+
+void bump(void)
+{
+  counter++;
+}
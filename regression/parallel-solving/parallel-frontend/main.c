@@ -0,0 +1,13 @@
+#include <assert.h>
+
+int counter;
+int add(int a, int b);
+void bump(void);
+
+int main()
+{
+  bump();
+  bump();
+  assert(add(counter, 1) == 4);
+  return 0;
+}
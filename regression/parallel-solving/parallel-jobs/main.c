@@ -0,0 +1,13 @@
+#include <assert.h>
+extern int __VERIFIER_nondet_int(void);
+
+int main()
+{
+  int a = __VERIFIER_nondet_int();
+  int b = a + 1;
+  assert(b != a);
+  assert(a == 0);
+  assert(b - a == 1);
+  assert(a != 42);
+  return 0;
+}
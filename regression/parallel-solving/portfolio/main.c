@@ -0,0 +1,11 @@
+#include <assert.h>
+
+unsigned nondet_uint();
+
+int main()
+{
+  unsigned x = nondet_uint();
+  unsigned y = x * 3 + 7;
+  assert(y != 31);
+  return 0;
+}
@@ -0,0 +1,4 @@
+import other
+
+assert other.OtherFunction() == 1
+assert other.OtherClass.foo() == 3
@@ -0,0 +1,7 @@
+def OtherFunction() -> int:
+    return 1
+
+class OtherClass:
+    @classmethod
+    def foo(cls) -> int:
+        return 3
@@ -0,0 +1,4 @@
+def length(s: str) -> int:
+    return len(s)
+
+assert length("abc") == 2
@@ -0,0 +1,5 @@
+def length(s: str) -> int:
+    return len(s)
+
+assert length("abc") == 3
+assert length("") == 0
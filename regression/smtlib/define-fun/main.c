@@ -0,0 +1,10 @@
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  int y = x * x + 3 * x;
+  __ESBMC_assume(y > 0);
+  __ESBMC_assert(y != 10, "shared");
+  return 0;
+}
@@ -70,10 +70,18 @@ class TestCase:
             for line in fp:
                 self.test_regex.append(line.strip())
 
-    def generate_run_argument_list(self, *tool):
+        # Optional arguments of a first run on the same file, whose output is
+        # not checked, e.g. to fill a cache that the checked run then uses
+        warm_up_path = os.path.join(self.test_dir, "warm-up.args")
+        if os.path.exists(warm_up_path):
+            with open(warm_up_path) as fp:
+                self.warm_up_args = fp.readline().strip()
+
+    def generate_run_argument_list(self, *tool, warm_up=False):
         """Generates run command list to be used in Popen"""
         result = list(tool)
-        for x in shlex.split(self.test_args):
+        args = self.warm_up_args if warm_up else self.test_args
+        for x in shlex.split(args):
             if x != "":
                 p = os.path.join(self.test_dir, x)
                 result.append(p if os.path.exists(p) else x)
@@ -104,6 +112,7 @@ class TestCase:
         self.name = name
         self.test_dir = test_dir
         self.test_args = None
+        self.warm_up_args = None
         self.test_file = None
         self.test_mode = "CORE"
         self._initialize_test_case()
@@ -134,8 +143,11 @@ class Executor:
 
     def run(self, test_case: TestCase):
         """Execute the test case with `executable`"""
-        cmd = test_case.generate_run_argument_list(*self.tool)
+        if test_case.warm_up_args is not None:
+            self._run(test_case.generate_run_argument_list(*self.tool, warm_up=True))
+        return self._run(test_case.generate_run_argument_list(*self.tool))
 
+    def _run(self, cmd):
         try:
             # use subprocess.run because we want to wait for the subprocess to finish
             p = subprocess.run(
@@ -147,5 +147,30 @@ class ToolTest2(CTest4):
         self.assertEqual(argument_list, expected, str(argument_list))
 
 
+class WarmUpTest(ParseTest):
+    """Added testcase with a first run before the checked one"""
+
+    def setUp(self):
+        self.test_case: TestCase = TestCase(
+            "./esbmc/result_cache_hit", "result_cache_hit")
+        self.test_parsed: TestCase = TestCase(
+            "./esbmc/result_cache_hit", "result_cache_hit")
+
+    def _read_file_checks(self, test_obj: TestCase):
+        self.assertEqual(self.test_case.test_args,
+                         "--result-cache esbmc-result-cache-hit")
+        self.assertEqual(self.test_case.warm_up_args,
+                         "--result-cache esbmc-result-cache-hit")
+
+    def _argument_list_checks(self, test_obj: TestCase):
+        argument_list = self.test_case.generate_run_argument_list(
+            "__test__", warm_up=True)
+        expected = ['__test__',
+                    '--result-cache', 'esbmc-result-cache-hit', './esbmc/result_cache_hit/main.c']
+        self.assertEqual(argument_list, expected, str(argument_list))
+        # Tests without a warm-up file only run once
+        self.assertIsNone(TestCase("./llvm/arr", "arr").warm_up_args)
+
+
 if __name__ == '__main__':
     unittest.main()
@@ -3,6 +3,9 @@
 #include <c2goto/cprover_library.h>
 #include <cstdlib>
 #include <fstream>
+#include <map>
+#include <mutex>
+#include <unordered_set>
 #include <goto-programs/goto_binary_reader.h>
 #include <goto-programs/goto_functions.h>
 #include <util/c_link.h>
@@ -92,6 +95,7 @@ const static std::vector<std::string> python_c_models = {
   "strncmp",
   "strcmp",
   "strlen",
+  "__strlen_impl",
   "ceil",
   "__ceil_array",
   "fegetround",
@@ -189,25 +193,30 @@ static void generate_symbol_deps(
   }
 }
 
-static void ingest_symbol(
-  irep_idt name,
-  std::multimap<irep_idt, irep_idt> &deps,
-  std::list<irep_idt> &to_include)
+/* The embedded libraries are read once per process, whatever the number of
+ * times the library is added. Indexed by the buffer and by whether only the
+ * Python models were read. */
+static const contextt &read_cprover_library(const buffer &clib, bool python)
 {
-  std::pair<
-    std::multimap<irep_idt, irep_idt>::const_iterator,
-    std::multimap<irep_idt, irep_idt>::const_iterator>
-    range;
-  std::multimap<irep_idt, irep_idt>::const_iterator it;
-
-  range = deps.equal_range(name);
-  if (range.first == range.second)
-    return;
+  static std::mutex mutex;
+  static std::map<std::pair<const buffer *, bool>, contextt> parsed;
 
-  for (it = range.first; it != range.second; it++)
-    to_include.push_back(it->second);
+  std::lock_guard lock(mutex);
+  auto [it, inserted] = parsed.try_emplace({&clib, python});
+  if (!inserted)
+    return it->second;
+
+  goto_binary_reader goto_reader;
+  if (python)
+    goto_reader.set_functions_to_read(python_c_models);
+
+  // The library carries no goto functions, only the symbols' code
+  goto_functionst goto_functions;
+  if (goto_reader.read_goto_binary_array(
+        clib.start, clib.size, it->second, goto_functions))
+    abort();
 
-  deps.erase(name);
+  return it->second;
 }
 
 void add_cprover_library(contextt &context, const languaget *language)
@@ -215,9 +224,9 @@ void add_cprover_library(contextt &context, const languaget *language)
   if (config.ansi_c.lib == configt::ansi_ct::libt::LIB_NONE)
     return;
 
-  contextt new_ctx, store_ctx;
-  goto_functionst goto_functions;
+  contextt store_ctx;
   std::multimap<irep_idt, irep_idt> symbol_deps;
+  std::unordered_set<irep_idt, irep_id_hash> ingested;
   std::list<irep_idt> to_include;
   const buffer *clib;
 
@@ -246,19 +255,8 @@ void add_cprover_library(contextt &context, const languaget *language)
     abort();
   }
 
-  goto_binary_reader goto_reader;
-
-  if (language && language->id() == "python")
-    goto_reader.set_functions_to_read(python_c_models);
-
-  if (goto_reader.read_goto_binary_array(
-        clib->start, clib->size, new_ctx, goto_functions))
-    abort();
-
-  new_ctx.foreach_operand([&symbol_deps](const symbolt &s) {
-    generate_symbol_deps(s.id, s.value, symbol_deps);
-    generate_symbol_deps(s.id, s.type, symbol_deps);
-  });
+  const bool python = language && language->id() == "python";
+  const contextt &new_ctx = read_cprover_library(*clib, python);
 
   // Add two hacks; we might use either pthread_mutex_lock or the checked
   // variant; so if one version is used, pull in the other too.
@@ -274,34 +272,39 @@ void add_cprover_library(contextt &context, const languaget *language)
     dstring("pthread_join"), dstring("pthread_join_noswitch"));
   symbol_deps.insert(joincheck);
 
+  /* Only the symbols pulled in are walked for their dependencies, which are
+   * queued in to_include; most of the library is never looked at. */
+  auto ingest_symbol = [&](const symbolt &s) {
+    store_ctx.add(s);
+    if (!ingested.insert(s.id).second)
+      return;
+
+    generate_symbol_deps(s.id, s.value, symbol_deps);
+    generate_symbol_deps(s.id, s.type, symbol_deps);
+    auto range = symbol_deps.equal_range(s.id);
+    for (auto it = range.first; it != range.second; it++)
+      to_include.push_back(it->second);
+    symbol_deps.erase(s.id);
+  };
+
   /* The code just pulled into store_ctx might use other symbols in the C
    * library. So, repeatedly search for new C library symbols that we use but
    * haven't pulled in, then pull them in. We finish when we've made a pass
    * that adds no new symbols. */
 
-  new_ctx.foreach_operand(
-    [&context, &store_ctx, &symbol_deps, &to_include, &language](
-      const symbolt &s) {
-      const symbolt *symbol = context.find_symbol(s.id);
-      if (
-        (language && language->id() == "python") ||
-        (symbol != nullptr && symbol->value.is_nil()))
-      {
-        store_ctx.add(s);
-        ingest_symbol(s.id, symbol_deps, to_include);
-      }
-    });
+  new_ctx.foreach_operand([&context, &ingest_symbol, python](const symbolt &s) {
+    const symbolt *symbol = context.find_symbol(s.id);
+    if (python || (symbol != nullptr && symbol->value.is_nil()))
+      ingest_symbol(s);
+  });
 
   for (std::list<irep_idt>::const_iterator nameit = to_include.begin();
        nameit != to_include.end();
        nameit++)
   {
-    symbolt *s = new_ctx.find_symbol(*nameit);
+    const symbolt *s = new_ctx.find_symbol(*nameit);
     if (s != nullptr)
-    {
-      store_ctx.add(*s);
-      ingest_symbol(*nameit, symbol_deps, to_include);
-    }
+      ingest_symbol(*s);
   }
 
   if (c_link(context, store_ctx, "<built-in-library>"))
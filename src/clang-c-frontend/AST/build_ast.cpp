@@ -55,8 +55,11 @@ static clang::driver::Driver *newDriver(
 
 std::unique_ptr<clang::ASTUnit> buildASTs(
   const std::string &intrinsics,
-  const std::vector<std::string> &compiler_args)
+  const std::vector<std::string> &compiler_args,
+  llvm::raw_ostream *diagnostics)
 {
+  llvm::raw_ostream &diag_out = diagnostics ? *diagnostics : llvm::errs();
+
   // Create virtual file system to add clang's headers
   llvm::IntrusiveRefCntPtr<llvm::vfs::OverlayFileSystem> OverlayFileSystem(
     new llvm::vfs::OverlayFileSystem(llvm::vfs::getRealFileSystem()));
@@ -87,7 +90,7 @@ std::unique_ptr<clang::ASTUnit> buildASTs(
 
   clang::ParseDiagnosticArgs(*DiagOpts, ParsedArgs);
 
-  clang::TextDiagnosticPrinter DiagnosticPrinter(llvm::errs(), &*DiagOpts);
+  clang::TextDiagnosticPrinter DiagnosticPrinter(diag_out, &*DiagOpts);
 
   clang::DiagnosticsEngine *Diagnostics = new clang::DiagnosticsEngine(
     llvm::IntrusiveRefCntPtr<clang::DiagnosticIDs>(new clang::DiagnosticIDs()),
@@ -114,9 +117,9 @@ std::unique_ptr<clang::ASTUnit> buildASTs(
   // Show the invocation, with -v.
   if (Invocation->getHeaderSearchOpts().Verbose)
   {
-    llvm::errs() << "clang Invocation:\n";
-    Compilation->getJobs().Print(llvm::errs(), "\n", true);
-    llvm::errs() << "\n";
+    diag_out << "clang Invocation:\n";
+    Compilation->getJobs().Print(diag_out, "\n", true);
+    diag_out << "\n";
   }
 
   // Create our custom action
@@ -14,9 +14,16 @@ namespace clang
 class ASTUnit;
 } // namespace clang
 
+namespace llvm
+{
+class raw_ostream;
+} // namespace llvm
+
+/// Diagnostics are written to diagnostics, or to llvm::errs() if it's null
 std::unique_ptr<clang::ASTUnit> buildASTs(
   const std::string &intrinsics,
-  const std::vector<std::string> &compiler_args);
+  const std::vector<std::string> &compiler_args,
+  llvm::raw_ostream *diagnostics = nullptr);
 
 void mergeASTs(
   const std::unique_ptr<clang::ASTUnit> &FromUnit,
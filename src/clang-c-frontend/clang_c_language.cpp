@@ -2,6 +2,7 @@
 CC_DIAGNOSTIC_PUSH()
 CC_DIAGNOSTIC_IGNORE_LLVM_CHECKS()
 #include <clang/Frontend/ASTUnit.h>
+#include <llvm/Support/raw_ostream.h>
 CC_DIAGNOSTIC_POP()
 
 #include <AST/build_ast.h>
@@ -17,6 +18,7 @@ CC_DIAGNOSTIC_POP()
 #include <util/c_link.h>
 
 #include <util/filesystem.h>
+#include <util/thread_pool.h>
 
 #include <ac_config.h>
 
@@ -317,6 +319,65 @@ bool clang_c_languaget::parse(const std::string &path)
   return false;
 }
 
+bool clang_c_languaget::parse_files(const std::vector<std::string> &paths)
+{
+  /* The files don't share anything until they are merged, so their ASTUnits
+   * are built at the same time. They are then merged in the order given, as
+   * if they had been parsed one after the other. */
+  const std::vector<std::string> args = compiler_args("clang-tool");
+  const std::string intrinsics = internal_additions();
+
+  for (const std::string &path : paths)
+  {
+    std::ostringstream o_preprocessed;
+    if (preprocess(path, o_preprocessed))
+      return true;
+
+    if (FILE *f = messaget::state.target("clang", VerbosityLevel::Debug))
+    {
+      fprintf(f, "clang invocation:");
+      for (const std::string &s : args)
+        fprintf(f, " '%s'", s.c_str());
+      fprintf(f, " '%s'\n", path.c_str());
+    }
+  }
+
+  const std::string num_jobs = config.options.get_option("parallel-jobs");
+  thread_poolt pool(num_jobs.empty() ? 0 : std::stoul(num_jobs));
+
+  // Each file's diagnostics are buffered, to print them in the order of
+  // the files rather than interleaved as the threads produce them
+  std::vector<std::unique_ptr<clang::ASTUnit>> units(paths.size());
+  std::vector<std::string> diagnostics(paths.size());
+  for (size_t i = 0; i < paths.size(); i++)
+    pool.submit([&, i] {
+      std::vector<std::string> file_args = args;
+      file_args.push_back(paths[i]);
+      llvm::raw_string_ostream out(diagnostics[i]);
+      units[i] = buildASTs(intrinsics, file_args, &out);
+      out.flush();
+    });
+  pool.wait();
+
+  for (const std::string &d : diagnostics)
+    llvm::errs() << d;
+
+  // Use diagnostics to find errors, rather than the return code.
+  for (const std::unique_ptr<clang::ASTUnit> &unit : units)
+    if (unit->getDiagnostics().hasErrorOccurred())
+      return true;
+
+  for (std::unique_ptr<clang::ASTUnit> &unit : units)
+  {
+    if (!AST)
+      AST = move(unit);
+    else
+      mergeASTs(unit, AST);
+  }
+
+  return false;
+}
+
 bool clang_c_languaget::typecheck(contextt &context, const std::string &)
 {
   clang_c_convertert converter(context, AST, "C");
@@ -388,6 +449,10 @@ _Bool __ESBMC_is_little_endian();
 int __ESBMC_rounding_mode = 0;
 
 void *__ESBMC_memset(void *, int, unsigned int);
+void *__ESBMC_memcpy(void *, const void *, __SIZE_TYPE__);
+void *__ESBMC_memmove(void *, const void *, __SIZE_TYPE__);
+int __ESBMC_memcmp(const void *, const void *, __SIZE_TYPE__);
+__SIZE_TYPE__ __ESBMC_strlen(const char *);
 
 /* same semantics as memcpy(tgt, src, size) where size matches the size of the
  * types tgt and src point to. */
@@ -19,6 +19,8 @@ public:
 
   bool parse(const std::string &path) override;
 
+  bool parse_files(const std::vector<std::string> &paths) override;
+
   bool final(contextt &context) override;
 
   bool typecheck(contextt &context, const std::string &module) override;
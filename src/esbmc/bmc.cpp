@@ -32,12 +32,15 @@
 #include <util/i2string.h>
 #include <irep2/irep2.h>
 #include <util/location.h>
+#include <util/prefix.h>
 
 #include <util/migrate.h>
 #include <util/show_symbol_table.h>
 #include <util/time_stopping.h>
 #include <util/cache.h>
+#include <util/thread_pool.h>
 #include <atomic>
+#include <future>
 #include <goto-symex/witnesses.h>
 
 std::unordered_set<std::string> goto_functionst::reached_claims;
@@ -48,6 +51,9 @@ std::mutex goto_functionst::reached_claims_mutex;
 std::mutex goto_functionst::reached_mul_claims_mutex;
 std::mutex goto_functionst::verified_claims_mutex;
 
+extern "C" const char buildidstring_buf[];
+extern "C" const unsigned int buildidstring_buf_size;
+
 bmct::bmct(goto_functionst &funcs, optionst &opts, contextt &_context)
   : options(opts), context(_context), ns(context)
 {
@@ -76,6 +82,14 @@ bmct::bmct(goto_functionst &funcs, optionst &opts, contextt &_context)
       algorithms.emplace_back(std::make_unique<ssa_features>());
   }
 
+  const std::string cache_dir = options.get_option("result-cache");
+  if (!cache_dir.empty())
+    // Results are only reused by the very same build
+    results = std::make_unique<result_cache>(
+      cache_dir,
+      options,
+      std::string(buildidstring_buf, buildidstring_buf_size));
+
   if (options.get_bool_option("smt-during-symex"))
   {
     runtime_solver = std::unique_ptr<smt_convt>(create_solver("", ns, options));
@@ -211,10 +225,79 @@ void bmct::keep_alive_function() const
   }
 }
 
+/* Releases the shared context while a solver runs and unregisters the solver
+ * from bmct::interrupt() afterwards, also when the solver throws. */
+class bmct::solving_sectiont
+{
+public:
+  solving_sectiont(const bmct &bmc, smt_convt &smt_conv)
+    : bmc(bmc), smt_conv(smt_conv)
+  {
+    if (bmc.context_mutex)
+      bmc.context_mutex->unlock();
+  }
+
+  ~solving_sectiont()
+  {
+    if (bmc.context_mutex)
+      bmc.context_mutex->lock();
+
+    std::lock_guard lock(bmc.solving_mutex);
+    bmc.solving.erase(&smt_conv);
+  }
+
+private:
+  const bmct &bmc;
+  smt_convt &smt_conv;
+};
+
+void bmct::interrupt()
+{
+  std::lock_guard lock(solving_mutex);
+  interrupted = true;
+  for (smt_convt *smt_conv : solving)
+    smt_conv->interrupt();
+}
+
+void bmct::interrupt_running_solvers() const
+{
+  std::lock_guard lock(solving_mutex);
+  for (smt_convt *smt_conv : solving)
+    smt_conv->interrupt();
+}
+
+void bmct::cancel_solving() const
+{
+  std::lock_guard lock(solving_mutex);
+  solving_cancelled = true;
+  for (smt_convt *smt_conv : solving)
+    smt_conv->interrupt();
+}
+
+void bmct::resume_solving() const
+{
+  std::lock_guard lock(solving_mutex);
+  solving_cancelled = false;
+}
+
 smt_convt::resultt bmct::run_decision_procedure(
   smt_convt &smt_conv,
   symex_target_equationt &eq) const
 {
+  const bool dump_formula = options.get_bool_option("smt-formula-too") ||
+                            options.get_bool_option("smt-formula-only");
+
+  std::string cache_key;
+  if (results && !dump_formula)
+  {
+    cache_key = results->key(eq.SSA_steps);
+    if (results->is_unsat(cache_key))
+    {
+      log_status("Formula found in the result cache, skipping the solver");
+      return smt_convt::P_UNSATISFIABLE;
+    }
+  }
+
   if (options.get_bool_option("enable-keep-alive"))
   {
     keep_alive_running = true;
@@ -229,9 +312,7 @@ smt_convt::resultt bmct::run_decision_procedure(
 
   generate_smt_from_equation(smt_conv, eq);
 
-  if (
-    options.get_bool_option("smt-formula-too") ||
-    options.get_bool_option("smt-formula-only"))
+  if (dump_formula)
   {
     smt_conv.dump_smt();
     if (options.get_bool_option("smt-formula-only"))
@@ -240,8 +321,23 @@ smt_convt::resultt bmct::run_decision_procedure(
 
   log_progress("Solving with solver {}", smt_conv.solver_text());
 
+  {
+    std::lock_guard lock(solving_mutex);
+    if (interrupted || solving_cancelled)
+    {
+      keep_alive_running = false;
+      return smt_convt::P_ERROR;
+    }
+    solving.insert(&smt_conv);
+  }
+
   fine_timet sat_start = current_time();
-  smt_convt::resultt dec_result = smt_conv.dec_solve();
+  smt_convt::resultt dec_result;
+  {
+    // Other users of the context may run symex while we are solving
+    solving_sectiont section(*this, smt_conv);
+    dec_result = smt_conv.dec_solve();
+  }
   fine_timet sat_stop = current_time();
   keep_alive_running = false;
 
@@ -249,6 +345,9 @@ smt_convt::resultt bmct::run_decision_procedure(
   log_status(
     "Runtime decision procedure: {}s", time2string(sat_stop - sat_start));
 
+  if (!cache_key.empty() && dec_result == smt_convt::P_UNSATISFIABLE)
+    results->store_unsat(cache_key);
+
   return dec_result;
 }
 
@@ -285,8 +384,8 @@ void bmct::show_program(const symex_target_equationt &eq)
 
     oss << "// " << it.source.pc->location_number << " ";
     oss << it.source.pc->location.as_string();
-    if (!it.comment.empty())
-      oss << " (" << it.comment << ")";
+    if (!it.comment().empty())
+      oss << " (" << it.comment() << ")";
     oss << "\n/* " << count << " */ ";
 
     std::string string_value;
@@ -888,6 +987,15 @@ smt_convt::resultt bmct::run(std::shared_ptr<symex_target_equationt> &eq)
   if (options.get_bool_option("schedule"))
     return run_thread(eq);
 
+  if (options.get_bool_option("parallel-interleavings"))
+  {
+    if (can_solve_interleavings_in_parallel())
+      return run_parallel_interleavings(eq);
+    log_warning(
+      "--parallel-interleavings is not supported with the given options, "
+      "solving the interleavings one by one");
+  }
+
   smt_convt::resultt res;
   do
   {
@@ -942,6 +1050,191 @@ smt_convt::resultt bmct::run(std::shared_ptr<symex_target_equationt> &eq)
   return interleaving_failed > 0 ? smt_convt::P_SATISFIABLE : res;
 }
 
+bool bmct::can_solve_interleavings_in_parallel() const
+{
+  // The caller already shares the context with other threads
+  if (context_mutex)
+    return false;
+
+  // Everything that needs to look at an interleaving before the next one is
+  // generated, or that doesn't solve it with a fresh solver
+  for (const char *opt :
+       {"program-only",
+        "document-subgoals",
+        "show-vcc",
+        "smt-formula-only",
+        "smt-formula-too",
+        "ltl",
+        "smt-during-symex",
+        "multi-property",
+        "reuse-symex",
+        "interactive-ileaves",
+        "smt-model",
+        "bidirectional"})
+    if (options.get_bool_option(opt))
+      return false;
+
+  return true;
+}
+
+smt_convt::resultt
+bmct::run_parallel_interleavings(std::shared_ptr<symex_target_equationt> &eq)
+{
+  /* Symex stays on this thread and explores the reachability tree as usual,
+   * including state hashing and MPOR. The formula of every interleaving is
+   * handed to a pool of solvers instead of being solved before the next
+   * interleaving is generated: while one batch of interleavings is being
+   * solved, symex generates the next one. */
+  const std::string num_jobs = options.get_option("parallel-jobs");
+  const std::string memlimit = options.get_option("parallel-memlimit");
+  thread_poolt pool(
+    num_jobs.empty() ? 0 : std::stoul(num_jobs),
+    memlimit.empty() ? 0 : std::stoull(memlimit));
+
+  log_status("Solving interleavings with {} parallel jobs", pool.num_workers());
+
+  // Symex adds symbols to the context while the solvers encode their
+  // formulas; solvers release it while they are solving
+  std::mutex symex_mutex;
+  context_mutex = &symex_mutex;
+
+  std::mutex result_mutex;
+  smt_convt::resultt res = smt_convt::P_UNSATISFIABLE;
+  std::shared_ptr<symex_target_equationt> failed_eq;
+  bool stop = false;
+  const bool all_runs = options.get_bool_option("all-runs");
+
+  auto solve_job = [this,
+                    &symex_mutex,
+                    &result_mutex,
+                    &res,
+                    &failed_eq,
+                    &stop,
+                    all_runs](
+                     std::shared_ptr<symex_target_equationt> ileave_eq) {
+    {
+      std::lock_guard lock(result_mutex);
+      if (stop)
+        return;
+    }
+
+    std::unique_ptr<smt_convt> solver;
+    smt_convt::resultt ileave_res;
+    try
+    {
+      std::lock_guard context_lock(symex_mutex);
+      solver = std::unique_ptr<smt_convt>(create_solver("", ns, options));
+      ileave_res = run_decision_procedure(*solver, *ileave_eq);
+    }
+    catch (std::string &error_str)
+    {
+      log_error("{}", error_str);
+      ileave_res = smt_convt::P_ERROR;
+    }
+    catch (const char *error_str)
+    {
+      log_error("{}", error_str);
+      ileave_res = smt_convt::P_ERROR;
+    }
+    catch (std::bad_alloc &)
+    {
+      log_error("Out of memory\n");
+      ileave_res = smt_convt::P_ERROR;
+    }
+
+    std::lock_guard lock(result_mutex);
+    // Solvers interrupted after a bug was found don't count
+    if (stop || ileave_res == smt_convt::P_UNSATISFIABLE)
+      return;
+
+    if (ileave_res == smt_convt::P_SATISFIABLE)
+    {
+      ++interleaving_failed;
+      // The first counterexample found is the one that gets reported
+      if (!failed_eq)
+      {
+        failed_eq = ileave_eq;
+        runtime_solver = std::move(solver);
+      }
+    }
+    else
+      res = ileave_res;
+
+    if (!all_runs)
+    {
+      stop = true;
+      interrupt_running_solvers();
+    }
+  };
+
+  std::vector<std::shared_ptr<symex_target_equationt>> batch;
+  std::future<void> solving;
+
+  auto flush = [&pool, &batch, &solving, &solve_job]() {
+    if (solving.valid())
+      solving.get();
+    for (auto &ileave_eq : batch)
+      pool.submit([&solve_job, ileave_eq]() { solve_job(ileave_eq); });
+    batch.clear();
+    solving = std::async(std::launch::async, [&pool]() { pool.wait(); });
+  };
+
+  auto stopped = [&result_mutex, &stop]() {
+    std::lock_guard lock(result_mutex);
+    return stop;
+  };
+
+  std::shared_ptr<symex_target_equationt> last_eq;
+  try
+  {
+    bool more;
+    do
+    {
+      if (++interleaving_number > 1)
+        log_status("Thread interleavings {}", interleaving_number);
+
+      std::shared_ptr<symex_target_equationt> ileave_eq;
+      goto_symext::symex_resultt symex_result = [&]() {
+        std::lock_guard context_lock(symex_mutex);
+        return symex_interleaving(ileave_eq);
+      }();
+
+      last_eq = ileave_eq;
+      if (symex_result.remaining_claims != 0)
+        batch.push_back(ileave_eq);
+      if (batch.size() == pool.num_workers())
+        flush();
+
+      std::lock_guard context_lock(symex_mutex);
+      more = !stopped() && symex->setup_next_formula();
+    } while (more);
+  }
+  catch (std::string &error_str)
+  {
+    log_error("{}", error_str);
+    res = smt_convt::P_ERROR;
+  }
+  catch (const char *error_str)
+  {
+    log_error("{}", error_str);
+    res = smt_convt::P_ERROR;
+  }
+  catch (std::bad_alloc &)
+  {
+    log_error("Out of memory\n");
+    res = smt_convt::P_ERROR;
+  }
+
+  if (!batch.empty() && !stopped())
+    flush();
+  if (solving.valid())
+    solving.get();
+
+  context_mutex = nullptr;
+  eq = failed_eq ? failed_eq : last_eq;
+  return interleaving_failed > 0 ? smt_convt::P_SATISFIABLE : res;
+}
+
 void bmct::bidirectional_search(
   smt_convt &smt_conv,
   const symex_target_equationt &eq)
@@ -963,7 +1256,7 @@ void bmct::bidirectional_search(
         return;
 
       // Save the location of the failed assertion
-      frames = ssait.stack_trace;
+      frames = ssait.stack_trace();
       assert_loop_number = ssait.loop_number;
 
       // We are not interested in instructions before the failed assertion yet
@@ -1071,49 +1364,136 @@ void bmct::bidirectional_search(
   }
 }
 
-smt_convt::resultt bmct::run_thread(std::shared_ptr<symex_target_equationt> &eq)
+goto_symext::symex_resultt
+bmct::symex_interleaving(std::shared_ptr<symex_target_equationt> &eq)
 {
   fine_timet symex_start = current_time();
-  try
-  {
-    goto_symext::symex_resultt solver_result =
-      options.get_bool_option("schedule") ? symex->generate_schedule_formula()
-                                          : symex->get_next_formula();
-
-    fine_timet symex_stop = current_time();
+  goto_symext::symex_resultt solver_result =
+    options.get_bool_option("schedule") ? symex->generate_schedule_formula()
+                                        : symex->get_next_formula();
 
-    eq =
-      std::dynamic_pointer_cast<symex_target_equationt>(solver_result.target);
+  fine_timet symex_stop = current_time();
 
-    log_status(
-      "Symex completed in: {}s ({} assignments)",
-      time2string(symex_stop - symex_start),
-      eq->SSA_steps.size());
+  eq = std::dynamic_pointer_cast<symex_target_equationt>(solver_result.target);
 
-    if (options.get_bool_option("double-assign-check"))
-      eq->check_for_duplicate_assigns();
+  log_status(
+    "Symex completed in: {}s ({} assignments)",
+    time2string(symex_stop - symex_start),
+    eq->SSA_steps.size());
 
-    BigInt ignored;
-    for (auto &a : algorithms)
-    {
-      a->run(eq->SSA_steps);
-      ignored += a->ignored();
-    }
+  if (options.get_bool_option("double-assign-check"))
+    eq->check_for_duplicate_assigns();
 
-    if (
-      options.get_bool_option("program-only") ||
-      options.get_bool_option("program-too"))
-      show_program(*eq);
+  BigInt ignored;
+  for (auto &a : algorithms)
+  {
+    a->run(eq->SSA_steps);
+    ignored += a->ignored();
+  }
 
-    if (options.get_bool_option("program-only"))
-      return smt_convt::P_SMTLIB;
+  if (
+    options.get_bool_option("program-only") ||
+    options.get_bool_option("program-too"))
+    show_program(*eq);
 
+  if (!options.get_bool_option("program-only"))
     log_status(
-      "Generated {} VCC(s), {} remaining after simplification ({} assignments)",
+      "Generated {} VCC(s), {} remaining after simplification ({} "
+      "assignments)",
       solver_result.total_claims,
       solver_result.remaining_claims,
       BigInt(eq->SSA_steps.size()) - ignored);
 
+  return solver_result;
+}
+
+smt_convt::resultt
+bmct::run_portfolio(std::shared_ptr<symex_target_equationt> &eq)
+{
+  std::vector<std::string> names;
+  std::istringstream list(options.get_option("portfolio"));
+  for (std::string name; std::getline(list, name, ',');)
+    if (!name.empty())
+      names.push_back(name);
+
+  log_status("Racing solvers {}", options.get_option("portfolio"));
+
+  /* Every solver writes its encoding into the SSA steps, so each one works
+   * on its own copy of the equation. */
+  std::vector<std::shared_ptr<symex_target_equationt>> eqs;
+  std::vector<std::unique_ptr<smt_convt>> solvers(names.size());
+  for (size_t i = 0; i < names.size(); i++)
+    eqs.push_back(std::static_pointer_cast<symex_target_equationt>(
+      i == 0 ? eq : eq->clone()));
+
+  std::mutex result_mutex;
+  std::optional<size_t> winner;
+  smt_convt::resultt res = smt_convt::P_ERROR;
+
+  thread_poolt pool(names.size());
+  for (size_t i = 0; i < names.size(); i++)
+    pool.submit([&, i]() {
+      smt_convt::resultt solver_res;
+      try
+      {
+        solvers[i] =
+          std::unique_ptr<smt_convt>(create_solver(names[i], ns, options));
+        solver_res = run_decision_procedure(*solvers[i], *eqs[i]);
+      }
+      catch (std::string &error_str)
+      {
+        log_error("{}", error_str);
+        solver_res = smt_convt::P_ERROR;
+      }
+      catch (const char *error_str)
+      {
+        log_error("{}", error_str);
+        solver_res = smt_convt::P_ERROR;
+      }
+      catch (std::bad_alloc &)
+      {
+        log_error("Out of memory\n");
+        solver_res = smt_convt::P_ERROR;
+      }
+
+      std::lock_guard lock(result_mutex);
+      if (winner)
+        return;
+
+      // Failing solvers leave the race to the others
+      if (
+        solver_res != smt_convt::P_SATISFIABLE &&
+        solver_res != smt_convt::P_UNSATISFIABLE)
+      {
+        res = solver_res;
+        return;
+      }
+
+      winner = i;
+      res = solver_res;
+      cancel_solving();
+    });
+  pool.wait();
+  resume_solving();
+
+  if (!winner)
+    return res;
+
+  log_status("Solver {} answered first", names[*winner]);
+  eq = eqs[*winner];
+  runtime_solver = std::move(solvers[*winner]);
+  return res;
+}
+
+smt_convt::resultt bmct::run_thread(std::shared_ptr<symex_target_equationt> &eq)
+{
+  try
+  {
+    goto_symext::symex_resultt solver_result = symex_interleaving(eq);
+
+    if (options.get_bool_option("program-only"))
+      return smt_convt::P_SMTLIB;
+
     if (options.get_bool_option("document-subgoals"))
     {
       std::ostringstream oss;
@@ -1138,6 +1518,10 @@ smt_convt::resultt bmct::run_thread(std::shared_ptr<symex_target_equationt> &eq)
         return smt_convt::P_SMTLIB;
       }
 
+      // No unwinding assertion either: every loop was fully unwound
+      if (options.get_bool_option("reuse-symex") && !forward_condition_result)
+        forward_condition_result = smt_convt::P_UNSATISFIABLE;
+
       return smt_convt::P_UNSATISFIABLE;
     }
 
@@ -1154,6 +1538,18 @@ smt_convt::resultt bmct::run_thread(std::shared_ptr<symex_target_equationt> &eq)
       return smt_convt::P_UNSATISFIABLE;
     }
 
+    // The checks below that solve more than one formula use a single
+    // solver, and formulas are only dumped once. The solvers of a portfolio
+    // can't release a context mutex held by the caller's thread.
+    if (
+      !options.get_option("portfolio").empty() && !context_mutex &&
+      !options.get_bool_option("smt-during-symex") &&
+      !options.get_bool_option("multi-property") &&
+      !options.get_bool_option("reuse-symex") &&
+      !options.get_bool_option("smt-formula-only") &&
+      !options.get_bool_option("smt-formula-too"))
+      return run_portfolio(eq);
+
     if (!options.get_bool_option("smt-during-symex"))
     {
       runtime_solver =
@@ -1166,6 +1562,11 @@ smt_convt::resultt bmct::run_thread(std::shared_ptr<symex_target_equationt> &eq)
       return multi_property_check(
         *eq, solver_result.remaining_claims, *runtime_solver);
 
+    if (
+      options.get_bool_option("reuse-symex") &&
+      options.get_bool_option("base-case"))
+      return run_base_case_and_forward_condition(*eq);
+
     return run_decision_procedure(*runtime_solver, *eq);
   }
 
@@ -1208,7 +1609,7 @@ int bmct::ltl_run_thread(symex_target_equationt &equation) const
     for (auto &SSA_step : equation.SSA_steps)
       if (SSA_step.is_assert())
       {
-        if (SSA_step.comment != which)
+        if (SSA_step.comment() != which)
           SSA_step.type = goto_trace_stept::SKIP;
         else
           num_asserts++;
@@ -1230,7 +1631,7 @@ int bmct::ltl_run_thread(symex_target_equationt &equation) const
     for (auto &SSA_step : equation.SSA_steps)
       if (SSA_step.is_skip())
         for (const auto &[which2, _] : seq)
-          if (SSA_step.comment == which2)
+          if (SSA_step.comment() == which2)
           {
             SSA_step.type = goto_trace_stept::ASSERT;
             break;
@@ -1253,6 +1654,75 @@ int bmct::ltl_run_thread(symex_target_equationt &equation) const
   return ltl_res_good;
 }
 
+static bool
+is_unwinding_assertion(const symex_target_equationt::SSA_stept &step)
+{
+  return step.is_assert() &&
+         (has_prefix(step.comment(), "unwinding assertion loop ") ||
+          step.comment() == "recursion unwinding assertion");
+}
+
+static void set_step_types(
+  const std::vector<symex_target_equationt::SSA_stept *> &steps,
+  goto_trace_stept::typet type)
+{
+  for (auto *SSA_step : steps)
+    SSA_step->type = type;
+}
+
+/* With --reuse-symex, the base case is symbolically executed with unwinding
+ * assertions, exactly like the forward condition. They are skipped while the
+ * base case is solved: symex already cuts the paths that exceed the bound
+ * through their guard, which is what the unwinding assumptions are for. If
+ * no bug is found, the very same equation is solved again with only the
+ * unwinding assertions enabled, which decides the forward condition without
+ * running symex a second time for this k. */
+smt_convt::resultt
+bmct::run_base_case_and_forward_condition(symex_target_equationt &eq)
+{
+  std::vector<symex_target_equationt::SSA_stept *> unwinding_asserts;
+  std::vector<symex_target_equationt::SSA_stept *> user_asserts;
+  for (auto &SSA_step : eq.SSA_steps)
+    if (is_unwinding_assertion(SSA_step))
+      unwinding_asserts.push_back(&SSA_step);
+    else if (SSA_step.is_assert())
+      user_asserts.push_back(&SSA_step);
+
+  // Base case
+  smt_convt::resultt res = smt_convt::P_UNSATISFIABLE;
+  if (!user_asserts.empty())
+  {
+    set_step_types(unwinding_asserts, goto_trace_stept::SKIP);
+    res = run_decision_procedure(*runtime_solver, eq);
+    set_step_types(unwinding_asserts, goto_trace_stept::ASSERT);
+  }
+
+  if (res != smt_convt::P_UNSATISFIABLE)
+    return res;
+
+  // Forward condition
+  smt_convt::resultt fc_res = smt_convt::P_UNSATISFIABLE;
+  if (!unwinding_asserts.empty())
+  {
+    log_progress("Checking forward condition on the same symbolic execution");
+    set_step_types(user_asserts, goto_trace_stept::SKIP);
+    std::unique_ptr<smt_convt> smt_conv(create_solver("", ns, options));
+    fc_res = run_decision_procedure(*smt_conv, eq);
+    set_step_types(user_asserts, goto_trace_stept::ASSERT);
+
+    if (fc_res == smt_convt::P_SATISFIABLE)
+      log_status("The forward condition is unable to prove the property");
+  }
+
+  // Every interleaving has to satisfy the forward condition
+  if (
+    !forward_condition_result ||
+    *forward_condition_result == smt_convt::P_UNSATISFIABLE)
+    forward_condition_result = fc_res;
+
+  return res;
+}
+
 smt_convt::resultt bmct::multi_property_check(
   const symex_target_equationt &eq,
   size_t remaining_claims,
@@ -1322,10 +1792,17 @@ smt_convt::resultt bmct::multi_property_check(
   // For color output
   bool is_color = options.get_bool_option("color");
 
-  // TODO: This is the place to check a cache
+  // Claims found UNSAT by an earlier run are answered from --result-cache
+  // in run_decision_procedure, once their formula has been sliced
   for (size_t i = 1; i <= remaining_claims; i++)
     jobs.emplace(i);
 
+  // The symbol dependencies of the equation are computed once, every claim
+  // is then sliced from them
+  std::unique_ptr<slice_dependency_grapht> slice_graph;
+  if (!options.get_bool_option("no-slice"))
+    slice_graph = std::make_unique<slice_dependency_grapht>(eq.SSA_steps);
+
   /* This is a JOB that will:
    * 1. Generate a solver instance for a specific claim (@parameter i)
    * 2. Solve the instance
@@ -1363,19 +1840,22 @@ smt_convt::resultt bmct::multi_property_check(
                        &fc,
                        &is,
                        &is_color,
+                       &slice_graph,
                        &runtime_solver](const size_t &i) {
     //"multi-fail-fast n": stop after first n SATs found.
     if (is_fail_fast && fail_fast_cnt >= fail_fast_limit)
       return;
 
-    // Since this is just a copy, we probably don't need a lock
-    symex_target_equationt local_eq = eq;
-
     // Set up the current claim and disable slice info output
     bool is_goto_cov =
       is_assert_cov || is_cond_cov || is_branch_cov || is_branch_func_cov;
     claim_slicer claim(i, false, is_goto_cov, ns);
-    claim.run(local_eq.SSA_steps);
+    auto claim_step = claim.find_claim(eq.SSA_steps);
+    if (claim_step == eq.SSA_steps.end())
+    {
+      log_error("Claim {} not found in the equation", i);
+      return;
+    }
 
     // Drop claims that verified to be failed
     // we use the "comment + location" to distinguish each claim
@@ -1403,7 +1883,6 @@ smt_convt::resultt bmct::multi_property_check(
 
     if (verified_claims.count(claim.claim_cstr))
     {
-      clear_verified_claims_in_ssa(local_eq, claim, is_goto_cov);
       clear_verified_claims_in_goto(claim, is_goto_cov);
       is_verified = true;
     }
@@ -1415,12 +1894,18 @@ smt_convt::resultt bmct::multi_property_check(
       return;
     }
 
-    // Slice
-    if (!options.get_bool_option("no-slice"))
+    /* The equation is shared by every claim, it is only read here. Instead
+     * of copying it and then ignoring most of it, only the steps that
+     * survive slicing for this claim are copied into the local equation. */
+    symex_target_equationt local_eq(ns);
+    if (slice_graph)
     {
       symex_slicet slicer(options);
-      slicer.run(local_eq.SSA_steps);
+      slicer.run_on_claim(
+        *slice_graph, eq.SSA_steps, claim_step, local_eq.SSA_steps);
     }
+    else
+      claim.copy_claim(eq.SSA_steps, claim_step, local_eq.SSA_steps);
 
     if (options.get_bool_option("ssa-features-dump"))
     {
@@ -1567,27 +2052,27 @@ smt_convt::resultt bmct::multi_property_check(
   // PARALLEL
   if (options.get_bool_option("parallel-solving"))
   {
-    /* NOTE: I would love to use std::for_each here, but it is not giving
-       * the result I would expect. My guess is either compiler version
-       * or some magic flag that we are not using.
-       *
-       * Nevertheless, we can achieve the same results by just creating
-       * threads.
-       */
-
-    // TODO: Running everything in parallel might be a bad idea.
-    //       Should we also add a thread pool?
-    std::vector<std::thread> parallel_jobs;
-    for (const auto &i : jobs)
-      parallel_jobs.push_back(std::thread(job_function, i));
-
-    // Main driver
-    for (auto &t : parallel_jobs)
-    {
-      t.join();
-    }
-    // We could remove joined jobs from the parallel_jobs vector.
-    // However, its probably not worth for small vectors.
+    /* Run the claims on a bounded pool of workers instead of spawning one
+     * thread per claim: at most --parallel-jobs solver instances are alive
+     * at the same time and no new one is started while the process is
+     * above --parallel-memlimit. The claims with the smallest sliced
+     * formulas are scheduled first. */
+    const std::string num_jobs = options.get_option("parallel-jobs");
+    const std::string memlimit = options.get_option("parallel-memlimit");
+    thread_poolt pool(
+      num_jobs.empty() ? 0 : std::stoul(num_jobs),
+      memlimit.empty() ? 0 : std::stoull(memlimit));
+
+    log_status(
+      "Solving {} claims with {} parallel jobs",
+      remaining_claims,
+      pool.num_workers());
+
+    for (const auto &i : order_claims_by_cost(
+           eq, slice_graph.get(), remaining_claims, pool))
+      pool.submit([&job_function, i]() { job_function(i); });
+
+    pool.wait();
   }
   // SEQUENTIAL
   else
@@ -1605,6 +2090,44 @@ smt_convt::resultt bmct::multi_property_check(
   return final_result;
 }
 
+std::vector<size_t> bmct::order_claims_by_cost(
+  const symex_target_equationt &eq,
+  const slice_dependency_grapht *graph,
+  size_t remaining_claims,
+  thread_poolt &pool) const
+{
+  std::vector<size_t> claims;
+  for (size_t i = 1; i <= remaining_claims; i++)
+    claims.push_back(i);
+
+  // Without the symex slicer, every claim keeps the whole equation
+  if (!graph)
+    return claims;
+
+  // Claims are numbered as claim_slicer::find_claim does
+  std::vector<symex_target_equationt::SSA_stepst::const_iterator> asserts;
+  for (auto it = eq.SSA_steps.begin(); it != eq.SSA_steps.end(); ++it)
+    if (it->is_assert())
+      asserts.push_back(it);
+
+  // Each size takes a backward pass over the equation, so they are computed
+  // concurrently. A claim that can't be found goes last.
+  std::vector<size_t> costs(remaining_claims, SIZE_MAX);
+  for (size_t i = 0; i < remaining_claims && i < asserts.size(); i++)
+    pool.submit([this, &eq, graph, &asserts, &costs, i]() {
+      symex_slicet slicer(options);
+      costs[i] = slicer.claim_size(*graph, eq.SSA_steps, asserts[i]);
+    });
+  pool.wait();
+
+  std::stable_sort(
+    claims.begin(), claims.end(), [&costs](size_t a, size_t b) {
+      return costs[a - 1] < costs[b - 1];
+    });
+
+  return claims;
+}
+
 void bmct::report_simple_summary(const SimpleSummary &summary) const
 {
   if (options.get_bool_option("result-only"))
@@ -8,12 +8,17 @@
 #include <langapi/language_ui.h>
 #include <list>
 #include <map>
+#include <mutex>
+#include <optional>
+#include <set>
 #include <solvers/smt/smt_conv.h>
 #include <solvers/smtlib/smtlib_conv.h>
 #include <solvers/solve.h>
 #include <util/options.h>
 #include <util/algorithms.h>
+#include <util/cache.h>
 #include <util/cmdline.h>
+#include <util/thread_pool.h>
 #include <atomic>
 
 class bmct
@@ -34,6 +39,19 @@ public:
   BigInt interleaving_number;
   BigInt interleaving_failed;
 
+  /// With --reuse-symex, outcome of the forward condition that was checked
+  /// on the symbolic execution of the base case, if it was checked at all
+  std::optional<smt_convt::resultt> forward_condition_result;
+
+  /// When set, the caller holds this mutex during start_bmc() and it is only
+  /// released while the solver runs, so that several instances running in
+  /// different threads can share one context
+  std::mutex *context_mutex = nullptr;
+
+  /// Make a running start_bmc() give up as soon as possible; may be called
+  /// from another thread
+  void interrupt();
+
   virtual smt_convt::resultt start_bmc();
   virtual smt_convt::resultt run(std::shared_ptr<symex_target_equationt> &eq);
   virtual ~bmct() = default;
@@ -44,9 +62,27 @@ protected:
 
   std::unique_ptr<smt_convt> runtime_solver;
   std::unique_ptr<reachability_treet> symex;
+  /// --result-cache, if given
+  std::unique_ptr<result_cache> results;
   mutable std::atomic<bool> keep_alive_running;
   mutable std::atomic<int> keep_alive_interval;
 
+  /// Solvers currently inside dec_solve(), for interrupt()
+  mutable std::mutex solving_mutex;
+  mutable std::set<smt_convt *> solving;
+  mutable bool interrupted = false;
+  /// Like interrupted, but lifted again by resume_solving()
+  mutable bool solving_cancelled = false;
+  class solving_sectiont;
+
+  /// Interrupts the solvers running right now, but not later ones
+  void interrupt_running_solvers() const;
+
+  /// Interrupts the running solvers and keeps new ones from starting until
+  /// resume_solving() is called
+  void cancel_solving() const;
+  void resume_solving() const;
+
   virtual smt_convt::resultt
   run_decision_procedure(smt_convt &smt_conv, symex_target_equationt &eq) const;
 
@@ -72,15 +108,43 @@ protected:
   virtual void
   bidirectional_search(smt_convt &smt_conv, const symex_target_equationt &eq);
 
+  /// Generates the formula of the next interleaving into eq and runs the
+  /// SSA step algorithms on it
+  goto_symext::symex_resultt
+  symex_interleaving(std::shared_ptr<symex_target_equationt> &eq);
+
   smt_convt::resultt run_thread(std::shared_ptr<symex_target_equationt> &eq);
 
+  /// --portfolio: solves eq with each of the listed solvers at the same time
+  /// and keeps the first one that answers; eq is replaced by the copy that
+  /// solver encoded, for the trace
+  smt_convt::resultt run_portfolio(std::shared_ptr<symex_target_equationt> &eq);
+
+  /// --parallel-interleavings: solve interleavings while symex generates
+  /// the next ones
+  bool can_solve_interleavings_in_parallel() const;
+  smt_convt::resultt
+  run_parallel_interleavings(std::shared_ptr<symex_target_equationt> &eq);
+
   int ltl_run_thread(symex_target_equationt &equation) const;
 
+  smt_convt::resultt
+  run_base_case_and_forward_condition(symex_target_equationt &eq);
+
   smt_convt::resultt multi_property_check(
     const symex_target_equationt &eq,
     size_t remaining_claims,
     smt_convt &runtime_solver);
 
+  /// Claims 1..remaining_claims ordered from the cheapest to the most
+  /// expensive one, by the number of steps the symex slicer keeps for them.
+  /// The sizes are computed on \pool; without a \graph the order is kept.
+  std::vector<size_t> order_claims_by_cost(
+    const symex_target_equationt &eq,
+    const slice_dependency_grapht *graph,
+    size_t remaining_claims,
+    thread_poolt &pool) const;
+
   std::vector<std::unique_ptr<ssa_step_algorithm>> algorithms;
 
   void generate_smt_from_equation(
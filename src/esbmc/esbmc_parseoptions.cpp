@@ -48,6 +48,9 @@ extern "C"
 #include <langapi/languages.h>
 #include <langapi/mode.h>
 #include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 #include <pointer-analysis/goto_program_dereference.h>
 #include <pointer-analysis/show_value_sets.h>
 #include <pointer-analysis/value_set_analysis.h>
@@ -79,18 +82,60 @@ static std::string_view esbmc_version_string()
   return {buildidstring_buf, buildidstring_buf_size};
 }
 
-enum PROCESS_TYPE
+enum KIND_WORKER
 {
   BASE_CASE,
   FORWARD_CONDITION,
-  INDUCTIVE_STEP,
-  PARENT
+  INDUCTIVE_STEP
 };
 
-struct resultt
+// State shared by the threads of the parallel k-induction, guarded by mutex
+struct k_induction_statet
 {
-  PROCESS_TYPE type;
-  uint64_t k;
+  std::mutex mutex;
+  std::condition_variable cv;
+
+  // Held by a worker while it runs bmc, except while its solver runs
+  std::mutex context_mutex;
+
+  // Set once the result is known, the workers do not start another step
+  bool stop = false;
+  bool failed = false;
+  bool finished[3] = {false, false, false};
+
+  // Set for a worker that was interrupted because the other side found a
+  // proof, its error result is not a failure of the run
+  bool cancelled[3] = {false, false, false};
+
+  // The bmc instance each worker is running at the moment, if any
+  bmct *running[3] = {nullptr, nullptr, nullptr};
+
+  // Highest k for which the base case did not find a bug
+  uint64_t bc_checked = 0;
+
+  // The k at which a bug or a proof was found, 0 if none (yet)
+  uint64_t bc_solution = 0;
+  uint64_t fc_solution = 0;
+  uint64_t is_solution = 0;
+
+  bool proof_found() const
+  {
+    return fc_solution != 0 || is_solution != 0;
+  }
+
+  bool decided() const
+  {
+    if (failed || bc_solution != 0)
+      return true;
+
+    // A proof needs the base case to be checked up to the same k
+    for (uint64_t k : {fc_solution, is_solution})
+      if (k != 0 && (k <= bc_checked || finished[BASE_CASE]))
+        return true;
+
+    return finished[BASE_CASE] && finished[FORWARD_CONDITION] &&
+           finished[INDUCTIVE_STEP];
+  }
 };
 
 #ifndef _WIN32
@@ -481,6 +526,28 @@ void esbmc_parseoptionst::get_command_line_options(optionst &options)
     options.set_option("multi-property", true);
   }
 
+  if (
+    cmdline.isset("parallel-jobs") && atoi(cmdline.getval("parallel-jobs")) < 1)
+  {
+    log_error("the value of parallel-jobs should be positive!");
+    abort();
+  }
+
+  if (
+    cmdline.isset("portfolio") &&
+    std::string(cmdline.getval("portfolio")).find_first_not_of(',') ==
+      std::string::npos)
+  {
+    log_error("--portfolio needs at least one solver");
+    abort();
+  }
+
+  // the scheduler works on bytes, keep --memlimit's suffixes for the user
+  if (cmdline.isset("parallel-memlimit"))
+    options.set_option(
+      "parallel-memlimit",
+      std::to_string(read_mem_spec(cmdline.getval("parallel-memlimit"))));
+
   // If multi-property is on, we should set base-case
   if (cmdline.isset("multi-property"))
   {
@@ -657,90 +724,29 @@ int esbmc_parseoptionst::doit()
   return do_bmc(bmc);
 }
 
-// This is the parallel version of k-induction algorithm.
-// This is an old implementation and should be revisited sometime in the
-// future.
+// This is the parallel version of k-induction algorithm. The program is
+// built once and the base case, forward condition and inductive step run
+// in their own threads, sharing the context and the goto functions.
 int esbmc_parseoptionst::doit_k_induction_parallel()
 {
-#ifdef _WIN32
-  log_error("Windows does not support parallel kind");
-  abort();
-#else
-  // Pipes for communication between processes
-  int forward_pipe[2], backward_pipe[2];
-
-  // Process type
-  PROCESS_TYPE process_type = PARENT;
-
-  if (pipe(forward_pipe))
-  {
-    log_status("\nPipe Creation Failed, giving up.");
-    _exit(1);
-  }
-
-  if (pipe(backward_pipe))
-  {
-    log_status("\nPipe Creation Failed, giving up.");
-    _exit(1);
-  }
-
-  /* Set file descriptor non-blocking */
-  fcntl(
-    backward_pipe[0], F_SETFL, fcntl(backward_pipe[0], F_GETFL) | O_NONBLOCK);
-
-  pid_t children_pid[3];
-  short num_p = 0;
-
-  // We need to fork 3 times: one for each step
-  for (unsigned p = 0; p < 3; ++p)
-  {
-    pid_t pid = fork();
-
-    if (pid == -1)
-    {
-      log_status("\nFork Failed, giving up.");
-      _exit(1);
-    }
+  optionst options;
 
-    // Child process
-    if (!pid)
-    {
-      process_type = PROCESS_TYPE(p);
-      break;
-    }
-    // Parent process
+  // Get full set of options
+  get_command_line_options(options);
 
-    children_pid[p] = pid;
-    ++num_p;
-  }
+  // Generate goto functions and set claims
+  if (get_goto_program(options, goto_functions))
+    return 6;
 
-  if (process_type == PARENT && num_p != 3)
+  if (cmdline.isset("show-claims"))
   {
-    log_error("Child processes were not created sucessfully.");
-    abort();
+    const namespacet ns(context);
+    show_claims(ns, goto_functions);
+    return 0;
   }
 
-  optionst options;
-
-  if (process_type != PARENT)
-  {
-    // Get full set of options
-    get_command_line_options(options);
-
-    // Generate goto functions and set claims
-    if (get_goto_program(options, goto_functions))
-      return 6;
-
-    if (cmdline.isset("show-claims"))
-    {
-      const namespacet ns(context);
-      show_claims(ns, goto_functions);
-      return 0;
-    }
-
-    if (set_claims(goto_functions))
-      return 7;
-  }
+  if (set_claims(goto_functions))
+    return 7;
 
   // Get max number of iterations
   uint64_t max_k_step = cmdline.isset("unlimited-k-steps")
@@ -760,476 +766,190 @@ int esbmc_parseoptionst::doit_k_induction_parallel()
     abort();
   }
 
-  // All processes were created successfully
-  switch (process_type)
-  {
-  case PARENT:
-  {
-    // Communication to child processes
-    close(forward_pipe[1]);
-    close(backward_pipe[0]);
-
-    struct resultt a_result;
-    bool bc_finished = false, fc_finished = false, is_finished = false;
-    uint64_t bc_solution = max_k_step, fc_solution = max_k_step,
-             is_solution = max_k_step;
-
-    // Keep reading until we find an answer
-    while (!(bc_finished && fc_finished && is_finished))
+  // The workers take the context mutex, don't let bmct spawn solver threads
+  // of its own that do not hold it
+  options.set_option("parallel-solving", false);
+  if (!options.get_option("portfolio").empty())
+  {
+    log_warning("--portfolio is ignored with --k-induction-parallel");
+    options.set_option("portfolio", "");
+  }
+
+  optionst bc_options = options;
+  bc_options.set_option("base-case", true);
+  bc_options.set_option("forward-condition", false);
+  bc_options.set_option("inductive-step", false);
+  bc_options.set_option("no-unwinding-assertions", true);
+  bc_options.set_option("partial-loops", false);
+  // The forward condition has a thread of its own
+  bc_options.set_option("reuse-symex", false);
+
+  optionst fc_options = options;
+  fc_options.set_option("base-case", false);
+  fc_options.set_option("forward-condition", true);
+  fc_options.set_option("inductive-step", false);
+  fc_options.set_option("no-unwinding-assertions", false);
+  fc_options.set_option("partial-loops", false);
+  fc_options.set_option("no-assertions", true);
+
+  optionst is_options = options;
+  is_options.set_option("base-case", false);
+  is_options.set_option("forward-condition", false);
+  is_options.set_option("inductive-step", true);
+  is_options.set_option("no-unwinding-assertions", true);
+  is_options.set_option("partial-loops", true);
+
+  k_induction_statet state;
+
+  // Each worker increases k until it finds a bug (base case) or a proof
+  // (forward condition and inductive step), or until it is told to stop
+  auto worker = [&](const KIND_WORKER which, optionst &opts, uint64_t k_step) {
+    static const char *const names[] = {
+      "base case", "forward condition", "inductive step"};
+
+    for (; k_step <= max_k_step; k_step += k_step_inc)
     {
-      // Perform read and interpret the number of bytes read
-      int read_size = read(forward_pipe[0], &a_result, sizeof(resultt));
-      if (read_size != sizeof(resultt))
-      {
-        if (read_size == 0)
-        {
-          // Client hung up; continue on, but don't interpret the result.
-          ;
-        }
-        else
-        {
-          // Invalid size read.
-          log_error("Short read communicating with kinduction children");
-          log_error("Size {}, expected {}", read_size, sizeof(resultt));
-          abort();
-        }
-      }
-
-      // Eventually the parent process will check if the child process is alive
-
-      // Check base case process
-      if (!bc_finished)
-      {
-        int status;
-        pid_t result = waitpid(children_pid[0], &status, WNOHANG);
-        if (result == 0)
-        {
-          // Child still alive
-        }
-        else if (result == -1)
-        {
-          // Error
-        }
-        else
-        {
-          log_warning("base case process crashed.");
-          bc_finished = fc_finished = is_finished = true;
-        }
-      }
-
-      // Check forward condition process
-      if (!fc_finished)
-      {
-        int status;
-        pid_t result = waitpid(children_pid[1], &status, WNOHANG);
-        if (result == 0)
-        {
-          // Child still alive
-        }
-        else if (result == -1)
-        {
-          // Error
-        }
-        else
-        {
-          log_warning("forward condition process crashed.");
-          fc_finished = bc_finished = is_finished = true;
-        }
-      }
-
-      // Check inductive step process
-      if (!is_finished)
-      {
-        int status;
-        pid_t result = waitpid(children_pid[2], &status, WNOHANG);
-        if (result == 0)
-        {
-          // Child still alive
-        }
-        else if (result == -1)
-        {
-          // Error
-        }
-        else
-        {
-          log_warning("inductive step process crashed.");
-          is_finished = bc_finished = fc_finished = true;
-        }
-      }
-
-      switch (a_result.type)
-      {
-      case BASE_CASE:
-        bc_finished = true;
-        bc_solution = a_result.k;
-        break;
-
-      case FORWARD_CONDITION:
-        fc_finished = true;
-        fc_solution = a_result.k;
-        break;
-
-      case INDUCTIVE_STEP:
-        is_finished = true;
-        is_solution = a_result.k;
-        break;
-
-      default:
-        log_error("Message from unrecognized k-induction child process");
-        abort();
-      }
-
-      // If either the base case found a bug or the forward condition
-      // finds a solution, present the result
-      if (bc_finished && (bc_solution != 0) && (bc_solution != max_k_step))
+      if (
+        (which == FORWARD_CONDITION &&
+         opts.get_bool_option("disable-forward-condition")) ||
+        (which == INDUCTIVE_STEP &&
+         opts.get_bool_option("disable-inductive-step")))
         break;
 
-      // If the either the forward condition or inductive step finds a
-      // solution, first check if base case couldn't find a bug in that code,
-      // if there is no bug, inductive step can present the result
-      if (fc_finished && (fc_solution != 0) && (fc_solution != max_k_step))
-      {
-        // If base case finished, then we can present the result
-        if (bc_finished)
-          break;
-
-        // Otherwise, kill the inductive step process
-        kill(children_pid[2], SIGKILL);
-
-        // And ask base case for a solution
-
-        // Struct to keep the result
-        struct resultt r = {process_type, 0};
-
-        r.k = fc_solution;
-
-        // Write result
-        auto const len = write(backward_pipe[1], &r, sizeof(r));
-        assert(len == sizeof(r) && "short write");
-        (void)len; //ndebug
-      }
+      // Symex and the counterexample generation add symbols to the shared
+      // context, only the solvers of the workers run concurrently
+      std::unique_lock context_lock(state.context_mutex);
+      bmct bmc(goto_functions, opts, context);
+      bmc.options.set_option("unwind", integer2string(k_step));
+      bmc.context_mutex = &state.context_mutex;
 
-      if (is_finished && (is_solution != 0) && (is_solution != max_k_step))
       {
-        // If base case finished, then we can present the result
-        if (bc_finished)
+        std::lock_guard lock(state.mutex);
+        if (state.stop || (which != BASE_CASE && state.proof_found()))
           break;
-
-        // Otherwise, kill the forward condition process
-        kill(children_pid[1], SIGKILL);
-
-        // And ask base case for a solution
-
-        // Struct to keep the result
-        struct resultt r = {process_type, 0};
-
-        r.k = is_solution;
-
-        // Write result
-        auto const len = write(backward_pipe[1], &r, sizeof(r));
-        assert(len == sizeof(r) && "short write");
-        (void)len; //ndebug
+        state.running[which] = &bmc;
       }
-    }
 
-    for (int i : children_pid)
-      kill(i, SIGKILL);
+      log_status("Checking {}, k = {:d}", names[which], k_step);
 
-    // Check if a solution was found by the base case
-    if (bc_finished && (bc_solution != 0) && (bc_solution != max_k_step))
-    {
-      log_result(
-        "\nBug found by the base case (k = {})\nVERIFICATION FAILED",
-        bc_solution);
-      return true;
-    }
-
-    // Check if a solution was found by the forward condition
-    if (fc_finished && (fc_solution != 0) && (fc_solution != max_k_step))
-    {
-      // We should only present the result if the base case finished
-      // and haven't crashed (if it crashed, bc_solution will be UINT_MAX
-      if (bc_finished && (bc_solution != max_k_step))
-      {
-        log_success(
-          "\nSolution found by the forward condition; "
-          "all states are reachable (k = {:d})\n"
-          "VERIFICATION SUCCESSFUL",
-          fc_solution);
-        return false;
-      }
-    }
-
-    // Check if a solution was found by the inductive step
-    if (is_finished && (is_solution != 0) && (is_solution != max_k_step))
-    {
-      // We should only present the result if the base case finished
-      // and haven't crashed (if it crashed, bc_solution will be UINT_MAX
-      if (bc_finished && (bc_solution != max_k_step))
-      {
-        log_success(
-          "\nSolution found by the inductive step "
-          "(k = {:d})\n"
-          "VERIFICATION SUCCESSFUL",
-          is_solution);
-        return false;
-      }
-    }
-
-    // Couldn't find a bug or a proof for the current depth
-    log_fail("\nVERIFICATION UNKNOWN");
-    return false;
-  }
-
-  case BASE_CASE:
-  {
-    // Set that we are running base case
-    options.set_option("base-case", true);
-    options.set_option("forward-condition", false);
-    options.set_option("inductive-step", false);
-
-    options.set_option("no-unwinding-assertions", true);
-    options.set_option("partial-loops", false);
-
-    // Start communication to the parent process
-    close(forward_pipe[0]);
-    close(backward_pipe[1]);
-
-    // Struct to keep the result
-    struct resultt r = {process_type, 0};
-
-    // Run bmc and only send results in two occasions:
-    // 1. A bug was found, we send the step where it was found
-    // 2. It couldn't find a bug
-    for (uint64_t k_step = k_step_base; k_step <= max_k_step;
-         k_step += k_step_inc)
-    {
-      bmct bmc(goto_functions, options, context);
-      bmc.options.set_option("unwind", integer2string(k_step));
-
-      log_progress("Checking base case, k = {:d}\n", k_step);
-
-      // If an exception was thrown, we should abort the process
-      int res = smt_convt::P_ERROR;
+      smt_convt::resultt res = smt_convt::P_ERROR;
       try
       {
-        res = do_bmc(bmc);
+        res = bmc.start_bmc();
       }
-      catch (...)
+      catch (std::string &error_str)
       {
-        break;
+        log_error("{}", error_str);
       }
-
-      // Send information to parent if no bug was found
-      if (res == smt_convt::P_SATISFIABLE)
+      catch (const char *error_str)
       {
-        r.k = k_step;
-
-        // Write result
-        auto const len = write(forward_pipe[1], &r, sizeof(r));
-        assert(len == sizeof(r) && "short write");
-        (void)len; //ndebug
-
-        log_status("Base case process finished (bug found).\n");
-        return true;
+        log_error("{}", error_str);
       }
-
-      // Check if the parent process is asking questions
-
-      // Perform read and interpret the number of bytes read
-      struct resultt a_result;
-      int read_size = read(backward_pipe[0], &a_result, sizeof(resultt));
-      if (read_size != sizeof(resultt))
+      catch (std::bad_alloc &)
       {
-        if (read_size == 0)
-        {
-          // Client hung up; continue on, but don't interpret the result.
-          continue;
-        }
-        if (read_size == -1 && errno == EAGAIN)
-        {
-          // No data available yet
-          continue;
-        }
-        else
-        {
-          // Invalid size read.
-          log_error("Short read communicating with kinduction parent");
-          log_error("Size {}, expected {}", read_size, sizeof(resultt));
-
-          abort();
-        }
+        log_error("Out of memory\n");
       }
 
-      // We only receive messages from the parent
-      assert(a_result.type == PARENT);
+      std::lock_guard lock(state.mutex);
+      state.running[which] = nullptr;
 
-      // If the value being asked is greater or equal the current step,
-      // then we can stop the base case. It can be equal, because we
-      // have just checked the current value of k
-      if (a_result.k < k_step)
+      if (state.stop || state.cancelled[which])
         break;
 
-      // Otherwise, we just need to check the base case for k = a_result.k
-      max_k_step = a_result.k + k_step_inc;
-    }
-
-    // Send information to parent that a bug was not found
-    r.k = 0;
-
-    auto const len = write(forward_pipe[1], &r, sizeof(r));
-    assert(len == sizeof(r) && "short write");
-    (void)len; //ndebug
-
-    log_status("Base case process finished (no bug found).\n");
-    return false;
-  }
-
-  case FORWARD_CONDITION:
-  {
-    // Set that we are running forward condition
-    options.set_option("base-case", false);
-    options.set_option("forward-condition", true);
-    options.set_option("inductive-step", false);
-
-    options.set_option("no-unwinding-assertions", false);
-    options.set_option("partial-loops", false);
-    options.set_option("no-assertions", true);
-
-    // Start communication to the parent process
-    close(forward_pipe[0]);
-    close(backward_pipe[1]);
-
-    // Struct to keep the result
-    struct resultt r = {process_type, 0};
-
-    // Run bmc and only send results in two occasions:
-    // 1. A proof was found, we send the step where it was found
-    // 2. It couldn't find a proof
-    for (uint64_t k_step = k_step_base + 1; k_step <= max_k_step;
-         k_step += k_step_inc)
-    {
-      bmct bmc(goto_functions, options, context);
-      bmc.options.set_option("unwind", integer2string(k_step));
-
-      log_status("Checking forward condition, k = {:d}", k_step);
-
-      // If an exception was thrown, we should abort the process
-      int res = smt_convt::P_ERROR;
-      try
-      {
-        res = do_bmc(bmc);
-      }
-      catch (...)
+      if (res == smt_convt::P_ERROR)
       {
+        log_warning("{} thread failed.", names[which]);
+        state.failed = true;
         break;
       }
 
-      if (options.get_bool_option("disable-forward-condition"))
-        break;
+      if (which == BASE_CASE)
+      {
+        if (res == smt_convt::P_SATISFIABLE)
+        {
+          state.bc_solution = k_step;
+          break;
+        }
+        state.bc_checked = k_step;
+        state.cv.notify_all();
+        continue;
+      }
 
-      // Send information to parent if no bug was found
       if (res == smt_convt::P_UNSATISFIABLE)
       {
-        r.k = k_step;
-
-        // Write result
-        auto const len = write(forward_pipe[1], &r, sizeof(r));
-        assert(len == sizeof(r) && "short write");
-        (void)len; //ndebug
+        (which == FORWARD_CONDITION ? state.fc_solution : state.is_solution) =
+          k_step;
 
-        log_status("Forward condition process finished (safety proven).");
-        return false;
+        // A single proof is enough, the other side can give up
+        const KIND_WORKER other =
+          which == FORWARD_CONDITION ? INDUCTIVE_STEP : FORWARD_CONDITION;
+        if (state.running[other])
+        {
+          state.cancelled[other] = true;
+          state.running[other]->interrupt();
+        }
+        break;
       }
     }
 
-    // Send information to parent that it couldn't prove the code
-    r.k = 0;
+    std::lock_guard lock(state.mutex);
+    state.finished[which] = true;
+    state.cv.notify_all();
+  };
 
-    auto const len = write(forward_pipe[1], &r, sizeof(r));
-    assert(len == sizeof(r) && "short write");
-    (void)len; //ndebug
+  std::thread threads[] = {
+    std::thread(worker, BASE_CASE, std::ref(bc_options), k_step_base),
+    std::thread(
+      worker, FORWARD_CONDITION, std::ref(fc_options), k_step_base + 1),
+    std::thread(worker, INDUCTIVE_STEP, std::ref(is_options), k_step_base + 1)};
 
-    log_status("Forward condition process finished (safety not proven).");
-    return true;
-  }
-
-  case INDUCTIVE_STEP:
   {
-    // Set that we are running inductive step
-    options.set_option("base-case", false);
-    options.set_option("forward-condition", false);
-    options.set_option("inductive-step", true);
-
-    options.set_option("no-unwinding-assertions", true);
-    options.set_option("partial-loops", true);
-
-    // Start communication to the parent process
-    close(forward_pipe[0]);
-    close(backward_pipe[1]);
-
-    // Struct to keep the result
-    struct resultt r = {process_type, 0};
-
-    // Run bmc and only send results in two occasions:
-    // 1. A proof was found, we send the step where it was found
-    // 2. It couldn't find a proof
-    for (uint64_t k_step = k_step_base + 1; k_step <= max_k_step;
-         k_step += k_step_inc)
-    {
-      bmct bmc(goto_functions, options, context);
-
-      bmc.options.set_option("unwind", integer2string(k_step));
-
-      log_status("Checking inductive step, k = {:d}", k_step);
-
-      // If an exception was thrown, we should abort the process
-      int res = smt_convt::P_ERROR;
-      try
-      {
-        res = do_bmc(bmc);
-      }
-      catch (...)
-      {
-        break;
-      }
-
-      if (options.get_bool_option("disable-inductive-step"))
-        break;
-
-      // Send information to parent if no bug was found
-      if (res == smt_convt::P_UNSATISFIABLE)
-      {
-        r.k = k_step;
+    std::unique_lock lock(state.mutex);
+    state.cv.wait(lock, [&state] { return state.decided(); });
 
-        // Write result
-        auto const len = write(forward_pipe[1], &r, sizeof(r));
-        assert(len == sizeof(r) && "short write");
-        (void)len; //ndebug
-
-        log_status("Inductive process finished (safety proven).");
-        return false;
-      }
-    }
-
-    // Send information to parent that it couldn't prove the code
-    r.k = 0;
+    // Stop the workers that are still running
+    state.stop = true;
+    for (bmct *bmc : state.running)
+      if (bmc)
+        bmc->interrupt();
+  }
 
-    auto const len = write(forward_pipe[1], &r, sizeof(r));
-    assert(len == sizeof(r) && "short write");
-    (void)len; //ndebug
+  for (std::thread &t : threads)
+    t.join();
 
-    log_status("Inductive process finished (safety not proven).");
+  // Check if a solution was found by the base case
+  if (state.bc_solution != 0)
+  {
+    log_result(
+      "\nBug found by the base case (k = {})\nVERIFICATION FAILED",
+      state.bc_solution);
     return true;
   }
 
-  default:
-    assert(0 && "Unknown process type.");
+  // A proof only holds if the base case did not find a bug up to that k
+  if (state.fc_solution != 0 && state.fc_solution <= state.bc_checked)
+  {
+    log_success(
+      "\nSolution found by the forward condition; "
+      "all states are reachable (k = {:d})\n"
+      "VERIFICATION SUCCESSFUL",
+      state.fc_solution);
+    return false;
   }
 
-#endif
+  if (state.is_solution != 0 && state.is_solution <= state.bc_checked)
+  {
+    log_success(
+      "\nSolution found by the inductive step "
+      "(k = {:d})\n"
+      "VERIFICATION SUCCESSFUL",
+      state.is_solution);
+    return false;
+  }
 
-  return 0;
+  // Couldn't find a bug or a proof for the current depth
+  log_fail("\nVERIFICATION UNKNOWN");
+  return false;
 }
 
 // This method iteratively applies one of the verification strategies
@@ -1274,6 +994,14 @@ int esbmc_parseoptionst::do_bmc_strategy(
     abort();
   }
 
+  // Check the forward condition on the symbolic execution of the base case.
+  // Multi-property needs every claim of the base case, so it is excluded.
+  const bool reuse_symex =
+    cmdline.isset("reuse-symex") &&
+    !options.get_bool_option("multi-property") &&
+    !options.get_bool_option("disable-forward-condition") &&
+    !options.get_bool_option("ltl");
+
   // Trying all bounds from 1 to "max_k_step" in "k_step_inc"
   for (uint64_t k_step = k_step_base; k_step <= max_k_step;
        k_step += k_step_inc)
@@ -1281,8 +1009,11 @@ int esbmc_parseoptionst::do_bmc_strategy(
     // k-induction
     if (options.get_bool_option("k-induction"))
     {
+      tvt fc_result(tvt::TV_UNKNOWN);
       bool is_bcv =
-        is_base_case_violated(options, goto_functions, k_step).is_true();
+        is_base_case_violated(
+          options, goto_functions, k_step, reuse_symex ? &fc_result : nullptr)
+          .is_true();
       if (
         is_bcv && !cmdline.isset("multi-property") &&
         !options.get_bool_option("multi-property"))
@@ -1292,7 +1023,10 @@ int esbmc_parseoptionst::do_bmc_strategy(
       // this will make the trace looks cleaner yet might lead to an extra round to terminate the verification
       if (
         !is_bcv &&
-        does_forward_condition_hold(options, goto_functions, k_step).is_false())
+        (reuse_symex
+           ? fc_result
+           : does_forward_condition_hold(options, goto_functions, k_step))
+          .is_false())
       {
         if (is_coverage)
           report_coverage(
@@ -1333,8 +1067,11 @@ int esbmc_parseoptionst::do_bmc_strategy(
     // incremental-bmc
     if (options.get_bool_option("incremental-bmc"))
     {
+      tvt fc_result(tvt::TV_UNKNOWN);
       bool is_bcv =
-        is_base_case_violated(options, goto_functions, k_step).is_true();
+        is_base_case_violated(
+          options, goto_functions, k_step, reuse_symex ? &fc_result : nullptr)
+          .is_true();
       if (
         is_bcv && !cmdline.isset("multi-property") &&
         !options.get_bool_option("multi-property"))
@@ -1342,7 +1079,10 @@ int esbmc_parseoptionst::do_bmc_strategy(
 
       if (
         !is_bcv &&
-        does_forward_condition_hold(options, goto_functions, k_step).is_false())
+        (reuse_symex
+           ? fc_result
+           : does_forward_condition_hold(options, goto_functions, k_step))
+          .is_false())
       {
         if (is_coverage)
           report_coverage(
@@ -1378,6 +1118,9 @@ int esbmc_parseoptionst::do_bmc_strategy(
 // \param options - options for controlling the symbolic execution
 // \param goto_function - GOTO program under investigation
 // \param k_step - depth to which all loops in the program are unrolled
+// \param forward_condition - if not null, the forward condition is also
+// decided on the same symbolic execution and its outcome (see
+// "does_forward_condition_hold") is stored here when no bug is found
 // \return
 //    TV_TRUE if such assertion violation (i.e., a bug) is found,
 //    TV_FALSE if all reachable assertions hold for all input values
@@ -1386,21 +1129,34 @@ int esbmc_parseoptionst::do_bmc_strategy(
 tvt esbmc_parseoptionst::is_base_case_violated(
   optionst &options,
   goto_functionst &goto_functions,
-  const uint64_t &k_step)
+  const uint64_t &k_step,
+  tvt *forward_condition)
 {
   options.set_option("base-case", true);
   options.set_option("forward-condition", false);
   options.set_option("inductive-step", false);
-  options.set_option("no-unwinding-assertions", true);
+  options.set_option("no-unwinding-assertions", forward_condition == nullptr);
   options.set_option("partial-loops", false);
+  options.set_option("reuse-symex", forward_condition != nullptr);
   options.set_option("unwind", integer2string(k_step));
 
   bmct bmc(goto_functions, options, context);
 
   log_progress("Checking base case, k = {:d}", k_step);
-  switch (do_bmc(bmc))
+  auto res = do_bmc(bmc);
+
+  // Don't leak the unwinding assertions into the other steps
+  options.set_option("reuse-symex", false);
+
+  switch (res)
   {
   case smt_convt::P_UNSATISFIABLE:
+    if (forward_condition && bmc.forward_condition_result)
+    {
+      log_progress("Checked forward condition, k = {:d}", k_step);
+      *forward_condition =
+        forward_condition_outcome(*bmc.forward_condition_result, k_step);
+    }
     return tvt(tvt::TV_FALSE);
 
   case smt_convt::P_SMTLIB:
@@ -1462,6 +1218,16 @@ tvt esbmc_parseoptionst::does_forward_condition_hold(
   // Restore the no assertion flag, before checking the other steps
   options.set_option("no-assertions", no_assertions);
 
+  return forward_condition_outcome(
+    static_cast<smt_convt::resultt>(res), k_step);
+}
+
+// Maps the result of solving the forward condition to the outcome
+// described in "does_forward_condition_hold".
+tvt esbmc_parseoptionst::forward_condition_outcome(
+  const smt_convt::resultt &res,
+  const uint64_t &k_step)
+{
   switch (res)
   {
   case smt_convt::P_SATISFIABLE:
@@ -54,13 +54,18 @@ protected:
   tvt is_base_case_violated(
     optionst &options,
     goto_functionst &goto_functions,
-    const uint64_t &k_step);
+    const uint64_t &k_step,
+    tvt *forward_condition = nullptr);
 
   tvt does_forward_condition_hold(
     optionst &options,
     goto_functionst &goto_functions,
     const uint64_t &k_step);
 
+  tvt forward_condition_outcome(
+    const smt_convt::resultt &res,
+    const uint64_t &k_step);
+
   tvt is_inductive_step_violated(
     optionst &options,
     goto_functionst &goto_functions,
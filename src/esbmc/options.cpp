@@ -75,6 +75,10 @@ const struct group_opt_templ all_cmd_options[] = {
      {"override-return-annotation",
       NULL,
       "Override return annotation with inferred type"},
+     {"python-ast-cache",
+      boost::program_options::value<std::string>()->value_name("dir"),
+      "keep the ASTs generated for Python scripts in dir and reuse them for "
+      "unchanged scripts in later runs"},
    }},
 #endif
 #ifdef ENABLE_SOLIDITY_FRONTEND
@@ -133,6 +137,9 @@ const struct group_opt_templ all_cmd_options[] = {
      "do not include abstract cpp operational models"},
     {"force,f", boost::program_options::value<std::vector<std::string>>(), ""},
     {"preprocess", NULL, "stop after preprocessing"},
+    {"parallel-frontend",
+     NULL,
+     "parse several C/C++ input files at the same time (see --parallel-jobs)"},
     {"no-inlining", NULL, "disable inlining function calls"},
     {"full-inlining", NULL, "perform full inlining of function calls"},
     {"all-claims", NULL, "keep all claims"},
@@ -268,13 +275,21 @@ const struct group_opt_templ all_cmd_options[] = {
     {"extended-try-analysis", NULL, ""},
     {"skip-bmc", NULL, "do not perform bounded model checking"},
     {"loop-invariant", NULL, "enable loop invariant checking"},
-    {"cache-asserts", NULL, "cache asserts that were already proven correct"}}},
+    {"cache-asserts", NULL, "cache asserts that were already proven correct"},
+    {"result-cache",
+     boost::program_options::value<std::string>()->value_name("dir"),
+     "keep the formulas proven UNSAT in dir and do not solve them again in "
+     "later runs"}}},
   {"Incremental BMC",
    {{"incremental-bmc", NULL, "incremental loop unwinding verification"},
     {"falsification", NULL, "incremental loop unwinding for bug searching"},
     {"termination",
      NULL,
-     "incremental loop unwinding assertion verification"}}},
+     "incremental loop unwinding assertion verification"},
+    {"reuse-symex",
+     NULL,
+     "check the base case and the forward condition of each step on the "
+     "same symbolic execution (k-induction and incremental-bmc)"}}},
   {"Solver",
    {{"list-solvers", NULL, "list available solvers and exit"},
     {"boolector", NULL, "use Boolector (default),"},
@@ -301,6 +316,18 @@ const struct group_opt_templ all_cmd_options[] = {
     {"parallel-solving",
      NULL,
      "solve each VCC in parallel (this activates --multi-property)"},
+    {"parallel-jobs",
+     boost::program_options::value<int>()->value_name("n"),
+     "solve at most n VCCs at the same time with --parallel-solving "
+     "(default: number of hardware threads)"},
+    {"parallel-memlimit",
+     boost::program_options::value<std::string>()->value_name("limit"),
+     "do not start solving another VCC with --parallel-solving while the "
+     "memory usage is above limit (same format as --memlimit)"},
+    {"portfolio",
+     boost::program_options::value<std::string>()->value_name("solvers"),
+     "solve the formula with each of the comma-separated solvers at the same "
+     "time and take the first answer, e.g. --portfolio z3,bitwuzla,yices"},
     {"smtlib", NULL, "use SMT lib format"},
     {"default-solver",
      boost::program_options::value<std::string>()->value_name("<solver>"),
@@ -429,7 +456,7 @@ const struct group_opt_templ all_cmd_options[] = {
      "conditions"},
     {"k-induction-parallel",
      NULL,
-     "prove by k-induction, running each step on a separate process"},
+     "prove by k-induction, running each step on a separate thread"},
     {"k-step",
      boost::program_options::value<int>()->default_value(1)->value_name("nr"),
      "set k increment (default is 1)"},
@@ -464,7 +491,11 @@ const struct group_opt_templ all_cmd_options[] = {
     {"no-por", NULL, "do not do partial order reduction"},
     {"all-runs",
      NULL,
-     "check all interleavings, even if a bug was already found"}}},
+     "check all interleavings, even if a bug was already found"},
+    {"parallel-interleavings",
+     NULL,
+     "solve several interleavings at the same time while the next ones are "
+     "generated (see --parallel-jobs and --parallel-memlimit)"}}},
   {"Interval Analysis",
    {{"interval-analysis",
      NULL,
@@ -24,8 +24,8 @@ void bmct::show_vcc(std::ostream &out, const symex_target_equationt &eq)
     if (it->source.pc->location.is_not_nil())
       out << it->source.pc->location << "\n";
 
-    if (it->comment != "")
-      out << it->comment << "\n";
+    if (it->comment() != "")
+      out << it->comment() << "\n";
 
     symex_target_equationt::SSA_stepst::const_iterator p_it =
       eq.SSA_steps.begin();
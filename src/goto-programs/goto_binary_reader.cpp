@@ -2,8 +2,9 @@
 #include <goto-programs/read_bin_goto_object.h>
 #include <goto-programs/goto_functions.h>
 #include <util/message.h>
-#include <fstream>
+#include <filesystem>
 #include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
 #include <boost/iostreams/stream.hpp>
 
 bool goto_binary_reader::read_goto_binary_array(
@@ -22,6 +23,28 @@ bool goto_binary_reader::read_goto_binary(
   contextt &context,
   goto_functionst &dest)
 {
-  std::ifstream in(path, std::ios::in | std::ios::binary);
-  return read_bin_goto_object(in, path, context, dest);
+  // An empty file can't be mapped, and holds no goto program either
+  std::error_code ec;
+  if (std::filesystem::is_empty(path, ec) && !ec)
+  {
+    log_error("`{}' is not a goto-binary", path);
+    return true;
+  }
+
+  // Map the file rather than reading it through a filebuf: the binary is
+  // only read once, front to back
+  using namespace boost::iostreams;
+  mapped_file_source file;
+  try
+  {
+    file.open(path);
+  }
+  catch (const std::exception &e)
+  {
+    log_error("{}", e.what());
+    return true;
+  }
+
+  stream<array_source> src(file.data(), file.size());
+  return read_bin_goto_object(src, path, context, dest);
 }
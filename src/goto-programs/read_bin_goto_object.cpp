@@ -1,13 +1,172 @@
 #include <goto-programs/goto_function_serialization.h>
 #include <goto-programs/goto_program_irep.h>
 #include <goto-programs/read_bin_goto_object.h>
+#include <goto-programs/write_goto_binary.h>
 #include <langapi/mode.h>
 #include <util/base_type.h>
 #include <util/irep_serialization.h>
 #include <util/namespace.h>
 #include <util/symbol_serialization.h>
 
-#define BINARY_VERSION 1
+// Written by write_goto_binary before the binaries had sections
+#define LEGACY_BINARY_VERSION 1
+
+/// Adds a symbol read from a binary, unless filtered out by `functions`
+static void add_symbol(
+  symbolt &symbol,
+  contextt &context,
+  const std::vector<std::string> &functions,
+  goto_functionst &goto_functions)
+{
+  if (!symbol.is_type && symbol.type.is_code())
+  {
+    // makes sure there is an empty function
+    // for every function symbol and fixes
+    // the function types.
+    auto it = goto_functions.function_map.find(symbol.id);
+    if (it == goto_functions.function_map.end())
+      goto_functions.function_map.emplace(symbol.id, goto_functiont());
+    goto_functions.function_map.at(symbol.id).type = to_code_type(symbol.type);
+  }
+
+  // Add functions only from the list
+  if (!functions.empty())
+  {
+    auto it = std::find(
+      functions.begin(), functions.end(), symbol.get_function_name().c_str());
+    if (it == functions.end())
+      return;
+  }
+
+  context.add(symbol);
+}
+
+static void add_function_body(
+  const irep_idt &fname,
+  const irept &t,
+  goto_functionst &goto_functions)
+{
+  auto it = goto_functions.function_map.find(fname);
+  if (it == goto_functions.function_map.end())
+    goto_functions.function_map.emplace(fname, goto_functiont());
+  goto_functiont &f = goto_functions.function_map.at(fname);
+  convert(t, f.body);
+  f.body_available = f.body.instructions.size() > 0;
+}
+
+static bool read_legacy_goto_object(
+  std::istream &in,
+  contextt &context,
+  const std::vector<std::string> &functions,
+  goto_functionst &goto_functions)
+{
+  irep_serializationt::ireps_containert ic;
+  irep_serializationt irepconverter(ic);
+  symbol_serializationt symbolconverter(ic);
+  goto_function_serializationt gfconverter(ic);
+
+  unsigned count = irepconverter.read_long(in);
+
+  for (unsigned i = 0; i < count; i++)
+  {
+    irept t;
+    symbolconverter.convert(in, t);
+    symbolt symbol;
+    symbol.from_irep(t);
+    add_symbol(symbol, context, functions, goto_functions);
+  }
+
+  assert(migrate_namespace_lookup);
+
+  count = irepconverter.read_long(in);
+  for (unsigned i = 0; i < count; i++)
+  {
+    irept t;
+    dstring fname = irepconverter.read_string(in);
+    gfconverter.convert(in, t);
+    add_function_body(fname, t, goto_functions);
+  }
+
+  return false;
+}
+
+// See write_goto_binary for the layout
+static bool read_sectioned_goto_object(
+  std::istream &in,
+  const std::string &filename,
+  contextt &context,
+  const std::vector<std::string> &functions,
+  goto_functionst &goto_functions)
+{
+  typedef irep_section_serializationt sectiont;
+
+  irep_string_tablet strings;
+  if (strings.read(in))
+  {
+    log_error("`{}' is truncated", filename);
+    return true;
+  }
+
+  struct entryt
+  {
+    irep_idt name;
+    irep_idt function;
+    unsigned flags = 0;
+    unsigned size = 0;
+  };
+
+  std::vector<entryt> symbols(sectiont::read_varint(in));
+  for (entryt &e : symbols)
+  {
+    e.name = strings.get(sectiont::read_varint(in));
+    e.function = strings.get(sectiont::read_varint(in));
+    e.flags = sectiont::read_varint(in);
+    e.size = sectiont::read_varint(in);
+  }
+
+  std::vector<entryt> bodies(sectiont::read_varint(in));
+  for (entryt &e : bodies)
+  {
+    e.name = strings.get(sectiont::read_varint(in));
+    e.size = sectiont::read_varint(in);
+  }
+
+  for (const entryt &e : symbols)
+  {
+    // Function symbols are always read, for their type
+    if (
+      !functions.empty() && !(e.flags & GOTO_BINARY_FUNCTION_SYMBOL) &&
+      std::find(functions.begin(), functions.end(), e.function.as_string()) ==
+        functions.end())
+    {
+      in.ignore(e.size);
+      continue;
+    }
+
+    irept t;
+    sectiont(strings).read(in, t);
+    symbolt symbol;
+    symbol.from_irep(t);
+    add_symbol(symbol, context, functions, goto_functions);
+  }
+
+  assert(migrate_namespace_lookup);
+
+  for (const entryt &e : bodies)
+  {
+    irept t;
+    sectiont(strings).read(in, t);
+    add_function_body(e.name, t, goto_functions);
+  }
+
+  if (!in.good())
+  {
+    log_error("`{}' is truncated", filename);
+    return true;
+  }
+
+  return false;
+}
 
 bool read_bin_goto_object(
   std::istream &in,
@@ -44,73 +203,19 @@ bool read_bin_goto_object(
     }
   }
 
-  irep_serializationt::ireps_containert ic;
-  irep_serializationt irepconverter(ic);
-  symbol_serializationt symbolconverter(ic);
-  goto_function_serializationt gfconverter(ic);
-
-  {
-    unsigned version = irepconverter.read_long(in);
-
-    if (version != BINARY_VERSION)
-    {
-      str << "The input was compiled with a different version of "
-          << "goto-cc, please recompile";
-      log_error("{}", str.str());
-      abort();
-    }
-  }
-
-  unsigned count = irepconverter.read_long(in);
+  unsigned version = irep_serializationt::read_long(in);
 
-  for (unsigned i = 0; i < count; i++)
-  {
-    irept t;
-    symbolconverter.convert(in, t);
-    symbolt symbol;
-    symbol.from_irep(t);
+  if (version == GOTO_BINARY_VERSION)
+    return read_sectioned_goto_object(
+      in, filename, context, functions, goto_functions);
 
-    if (!symbol.is_type && symbol.type.is_code())
-    {
-      // makes sure there is an empty function
-      // for every function symbol and fixes
-      // the function types.
-      auto it = goto_functions.function_map.find(symbol.id);
-      if (it == goto_functions.function_map.end())
-        goto_functions.function_map.emplace(symbol.id, goto_functiont());
-      goto_functions.function_map.at(symbol.id).type =
-        to_code_type(symbol.type);
-    }
+  if (version == LEGACY_BINARY_VERSION)
+    return read_legacy_goto_object(in, context, functions, goto_functions);
 
-    // Add functions only from the list
-    if (!functions.empty())
-    {
-      auto it = std::find(
-        functions.begin(), functions.end(), symbol.get_function_name().c_str());
-      if (it == functions.end())
-        continue;
-    }
-
-    context.add(symbol);
-  }
-
-  assert(migrate_namespace_lookup);
-
-  count = irepconverter.read_long(in);
-  for (unsigned i = 0; i < count; i++)
-  {
-    irept t;
-    dstring fname = irepconverter.read_string(in);
-    gfconverter.convert(in, t);
-    auto it = goto_functions.function_map.find(fname);
-    if (it == goto_functions.function_map.end())
-      goto_functions.function_map.emplace(fname, goto_functiont());
-    goto_functiont &f = goto_functions.function_map.at(fname);
-    convert(t, f.body);
-    f.body_available = f.body.instructions.size() > 0;
-  }
-
-  return false;
+  str << "The input was compiled with a different version of "
+      << "goto-cc, please recompile";
+  log_error("{}", str.str());
+  abort();
 }
 
 bool read_bin_goto_object(
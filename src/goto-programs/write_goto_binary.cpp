@@ -1,28 +1,44 @@
 #include <fstream>
-#include <goto-programs/goto_function_serialization.h>
+#include <goto-programs/goto_program_irep.h>
 #include <goto-programs/write_goto_binary.h>
+#include <sstream>
 #include <util/irep_serialization.h>
 #include <util/message.h>
-#include <util/symbol_serialization.h>
 
+/* Layout of the binary:
+ *   "GBF", version
+ *   string table
+ *   symbol directory: count, then name, function name, flags and size of
+ *                     the section of every symbol
+ *   function directory: count, then name and size of the section of every
+ *                       function body
+ *   the sections of the symbols, then those of the function bodies
+ * Sections can be read on their own, or skipped using their size. */
 bool write_goto_binary(
   std::ostream &out,
   const contextt &lcontext,
   goto_functionst &functions)
 {
-  // header
-  out << "GBF";
-  write_long(out, GOTO_BINARY_VERSION);
+  irep_string_tablet strings;
+  std::ostringstream directory, sections;
 
-  irep_serializationt::ireps_containert irepc;
-  irep_serializationt irepconverter(irepc);
-  symbol_serializationt symbolconverter(irepc);
-  goto_function_serializationt gfconverter(irepc);
+  irep_section_serializationt::write_varint(directory, lcontext.size());
+  lcontext.foreach_operand_in_order([&](const symbolt &s) {
+    irept t;
+    s.to_irep(t);
+    std::ostringstream section;
+    irep_section_serializationt(strings).write(section, t);
 
-  write_long(out, lcontext.size());
+    unsigned flags = 0;
+    if (!s.is_type && s.type.is_code())
+      flags |= GOTO_BINARY_FUNCTION_SYMBOL;
 
-  lcontext.foreach_operand([&symbolconverter, &out](const symbolt &s) {
-    symbolconverter.convert(s, out);
+    irep_section_serializationt::write_varint(directory, strings.add(s.id));
+    irep_section_serializationt::write_varint(
+      directory, strings.add(s.get_function_name()));
+    irep_section_serializationt::write_varint(directory, flags);
+    irep_section_serializationt::write_varint(directory, section.str().size());
+    sections << section.str();
   });
 
   unsigned cnt = 0;
@@ -30,20 +46,32 @@ bool write_goto_binary(
     if (it->second.body_available)
       cnt++;
 
-  write_long(out, cnt);
+  irep_section_serializationt::write_varint(directory, cnt);
 
   for (auto &it : functions.function_map)
   {
     if (it.second.body_available)
     {
       it.second.body.compute_location_numbers();
-      write_string(out, it.first.as_string());
-      gfconverter.convert(it.second, out);
+      irept t;
+      convert(it.second.body, t);
+      std::ostringstream section;
+      irep_section_serializationt(strings).write(section, t);
+
+      irep_section_serializationt::write_varint(
+        directory, strings.add(it.first));
+      irep_section_serializationt::write_varint(
+        directory, section.str().size());
+      sections << section.str();
     }
   }
 
-  //irepconverter.output_map(f);
-  //irepconverter.output_string_map(f);
+  // header
+  out << "GBF";
+  write_long(out, GOTO_BINARY_VERSION);
+
+  strings.write(out);
+  out << directory.str() << sections.str();
 
-  return false;
+  return !out;
 }
@@ -1,7 +1,10 @@
 #ifndef CPROVER_GOTO_PROGRAMS_WRITE_GOTO_BINARY_H_
 #define CPROVER_GOTO_PROGRAMS_WRITE_GOTO_BINARY_H_
 
-#define GOTO_BINARY_VERSION 1
+#define GOTO_BINARY_VERSION 2
+
+/* Flags of a symbol in the directory of a goto binary */
+#define GOTO_BINARY_FUNCTION_SYMBOL 1
 
 #include <goto-programs/goto_functions.h>
 #include <ostream>
@@ -1543,6 +1543,258 @@ void goto_symext::intrinsic_memset(
   symex_assign(code_assign2tc(ret_ref, arg0), false, cur_state->guard);
 }
 
+/* The intrinsics below build expressions that nest once per byte; longer
+ * copies and compares are left to the operational models in string.c. */
+static const uint64_t max_intrinsic_bytes = 4096;
+
+expr2tc goto_symext::byte_arrayt::byte(uint64_t i) const
+{
+  return index2tc(
+    to_array_type(value->type).subtype, value, gen_ulong(offset + i));
+}
+
+bool goto_symext::get_byte_array(const expr2tc &ptr, byte_arrayt &array)
+{
+  internal_deref_items.clear();
+  expr2tc deref = dereference2tc(get_empty_type(), ptr);
+  dereference(deref, dereferencet::INTERNAL);
+  if (internal_deref_items.size() != 1)
+    return false;
+
+  const dereference_callbackt::internal_item &item =
+    internal_deref_items.front();
+  if (!is_symbol2t(item.object) || !item.offset)
+    return false;
+
+  array.lhs = item.object;
+  array.value = item.object;
+  array.guard = item.guard;
+  expr2tc offset = item.offset;
+  cur_state->rename(array.value);
+  cur_state->rename(offset);
+  simplify(offset);
+  if (!is_constant_int2t(offset) || to_constant_int2t(offset).value < 0)
+    return false;
+
+  if (!is_array_type(array.value->type))
+    return false;
+
+  const array_type2t &arr = to_array_type(array.value->type);
+  if (
+    arr.size_is_infinite || !is_bv_type(arr.subtype) ||
+    arr.subtype->get_width() != 8)
+    return false;
+
+  expr2tc size = arr.array_size;
+  simplify(size);
+  if (!is_constant_int2t(size))
+    return false;
+
+  array.offset = to_constant_int2t(offset).as_ulong();
+  array.size = to_constant_int2t(size).as_ulong();
+  return array.offset <= array.size;
+}
+
+void goto_symext::check_byte_range(
+  const expr2tc &ptr,
+  uint64_t num_of_bytes,
+  dereferencet::modet mode)
+{
+  assert(num_of_bytes > 0);
+  type2tc byte_ptr = pointer_type2tc(get_uint8_type());
+  expr2tc first = typecast2tc(byte_ptr, ptr);
+  expr2tc last = add2tc(byte_ptr, first, gen_ulong(num_of_bytes - 1));
+
+  // The bytes in between are in the same object
+  for (const expr2tc &byte : {first, last})
+  {
+    expr2tc deref = dereference2tc(get_uint8_type(), byte);
+    dereference(deref, mode);
+  }
+}
+
+void goto_symext::intrinsic_memcpy(
+  reachability_treet &art,
+  const code_function_call2t &func_call,
+  const std::string &impl)
+{
+  assert(func_call.operands.size() == 3 && "Wrong memcpy signature");
+  const execution_statet &ex_state = art.get_cur_state();
+  if (ex_state.cur_state->guard.is_false())
+    return;
+
+  const expr2tc &dst_ptr = func_call.operands[0];
+  const expr2tc &src_ptr = func_call.operands[1];
+  expr2tc num = func_call.operands[2];
+  cur_state->rename(num);
+  simplify(num);
+
+  byte_arrayt dst, src;
+  if (
+    options.get_bool_option("no-simplify") || !is_constant_int2t(num) ||
+    to_constant_int2t(num).value > max_intrinsic_bytes ||
+    !get_byte_array(dst_ptr, dst) || !get_byte_array(src_ptr, src))
+  {
+    log_debug("memcpy", "Couldn't optimize the copy, calling {}", impl);
+    bump_call(func_call, impl);
+    return;
+  }
+
+  uint64_t number_of_bytes = to_constant_int2t(num).as_ulong();
+  if (
+    dst.size - dst.offset < number_of_bytes ||
+    src.size - src.offset < number_of_bytes)
+  {
+    // Let the operational model report the overflow
+    bump_call(func_call, impl);
+    return;
+  }
+
+  if (number_of_bytes > 0)
+  {
+    check_byte_range(src_ptr, number_of_bytes, dereferencet::READ);
+    check_byte_range(dst_ptr, number_of_bytes, dereferencet::WRITE);
+
+    /* Every byte is read from the source as it was before the call, which
+     * is also what memmove needs when both overlap. */
+    expr2tc new_object;
+    if (
+      dst.offset == 0 && src.offset == 0 && number_of_bytes == dst.size &&
+      dst.value->type == src.value->type)
+      new_object = src.value;
+    else
+    {
+      const type2tc &subtype = to_array_type(dst.value->type).subtype;
+      new_object = dst.value;
+      for (uint64_t i = 0; i < number_of_bytes; i++)
+      {
+        expr2tc byte = src.byte(i);
+        if (byte->type != subtype)
+          byte = typecast2tc(subtype, byte);
+        new_object = with2tc(
+          new_object->type, new_object, gen_ulong(dst.offset + i), byte);
+      }
+    }
+    guardt guard = cur_state->guard;
+    guard.add(dst.guard);
+    guard.add(src.guard);
+    symex_assign(code_assign2tc(dst.lhs, new_object), false, guard);
+  }
+
+  expr2tc ret_ref = func_call.ret;
+  if (is_nil_expr(ret_ref))
+    return;
+  dereference(ret_ref, dereferencet::READ);
+  symex_assign(code_assign2tc(ret_ref, dst_ptr), false, cur_state->guard);
+}
+
+void goto_symext::intrinsic_memcmp(
+  reachability_treet &art,
+  const code_function_call2t &func_call)
+{
+  assert(func_call.operands.size() == 3 && "Wrong memcmp signature");
+  const execution_statet &ex_state = art.get_cur_state();
+  if (ex_state.cur_state->guard.is_false())
+    return;
+
+  const expr2tc &ptr1 = func_call.operands[0];
+  const expr2tc &ptr2 = func_call.operands[1];
+  expr2tc num = func_call.operands[2];
+  cur_state->rename(num);
+  simplify(num);
+
+  byte_arrayt s1, s2;
+  if (
+    options.get_bool_option("no-simplify") || !is_constant_int2t(num) ||
+    to_constant_int2t(num).value > max_intrinsic_bytes ||
+    is_nil_expr(func_call.ret) || !get_byte_array(ptr1, s1) ||
+    !get_byte_array(ptr2, s2))
+  {
+    log_debug("memcmp", "Couldn't optimize memcmp");
+    bump_call(func_call, "c:@F@__memcmp_impl");
+    return;
+  }
+
+  uint64_t number_of_bytes = to_constant_int2t(num).as_ulong();
+  if (
+    s1.size - s1.offset < number_of_bytes ||
+    s2.size - s2.offset < number_of_bytes)
+  {
+    bump_call(func_call, "c:@F@__memcmp_impl");
+    return;
+  }
+
+  const type2tc &int_type = func_call.ret->type;
+  expr2tc result = gen_zero(int_type);
+  if (number_of_bytes > 0)
+  {
+    check_byte_range(ptr1, number_of_bytes, dereferencet::READ);
+    check_byte_range(ptr2, number_of_bytes, dereferencet::READ);
+
+    // The difference of the first bytes that differ, as unsigned chars
+    for (uint64_t i = number_of_bytes; i-- > 0;)
+    {
+      expr2tc a =
+        typecast2tc(int_type, typecast2tc(get_uint8_type(), s1.byte(i)));
+      expr2tc b =
+        typecast2tc(int_type, typecast2tc(get_uint8_type(), s2.byte(i)));
+      result = if2tc(
+        int_type, notequal2tc(a, b), sub2tc(int_type, a, b), result);
+    }
+  }
+
+  expr2tc ret_ref = func_call.ret;
+  dereference(ret_ref, dereferencet::READ);
+  symex_assign(code_assign2tc(ret_ref, result), false, cur_state->guard);
+}
+
+void goto_symext::intrinsic_strlen(
+  reachability_treet &art,
+  const code_function_call2t &func_call)
+{
+  assert(func_call.operands.size() == 1 && "Wrong strlen signature");
+  const execution_statet &ex_state = art.get_cur_state();
+  if (ex_state.cur_state->guard.is_false())
+    return;
+
+  const expr2tc &ptr = func_call.operands[0];
+  byte_arrayt s;
+  if (
+    options.get_bool_option("no-simplify") || is_nil_expr(func_call.ret) ||
+    !get_byte_array(ptr, s) || s.offset == s.size ||
+    s.size - s.offset > max_intrinsic_bytes)
+  {
+    log_debug("strlen", "Couldn't optimize strlen");
+    bump_call(func_call, "c:@F@__strlen_impl");
+    return;
+  }
+
+  check_byte_range(ptr, 1, dereferencet::READ);
+
+  // The position of the first null byte, if there is one in the array
+  const type2tc &size_type = func_call.ret->type;
+  const type2tc &subtype = to_array_type(s.value->type).subtype;
+  expr2tc result = constant_int2tc(size_type, BigInt(s.size - s.offset));
+  expr2tc terminated = gen_false_expr();
+  for (uint64_t i = s.size - s.offset; i-- > 0;)
+  {
+    expr2tc is_null = equality2tc(s.byte(i), gen_zero(subtype));
+    result =
+      if2tc(size_type, is_null, constant_int2tc(size_type, BigInt(i)), result);
+    terminated = or2tc(is_null, terminated);
+  }
+
+  // Otherwise the loop of the operational model reads past the array
+  if (
+    !options.get_bool_option("no-pointer-check") &&
+    !options.get_bool_option("no-bounds-check"))
+    claim(terminated, "dereference failure: array bounds violated");
+
+  expr2tc ret_ref = func_call.ret;
+  dereference(ret_ref, dereferencet::READ);
+  symex_assign(code_assign2tc(ret_ref, result), false, cur_state->guard);
+}
+
 void goto_symext::intrinsic_get_object_size(
   const code_function_call2t &func_call,
   reachability_treet &)
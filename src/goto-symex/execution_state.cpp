@@ -1129,38 +1129,20 @@ bool execution_statet::can_execution_continue() const
   return true;
 }
 
-crypto_hash execution_statet::generate_hash() const
+zobrist_hasht execution_statet::generate_hash() const
 {
   auto l2 = std::dynamic_pointer_cast<state_hashing_level2t>(state_level2);
   assert(l2 != nullptr);
 
-  crypto_hash state = l2->generate_l2_state_hash();
-  std::string str = state.to_string();
-
-  for (const auto &it : threads_state)
-  {
-    goto_programt::const_targett pc = it.source.pc;
-    int id = pc->location_number;
-    std::stringstream s;
-    s << id;
-    str += "!" + s.str();
-  }
-
-  crypto_hash h;
-  h.ingest(str.c_str(), str.size());
-  h.fin();
+  // The PCs change on every step, so they are only added in here, which
+  // costs one XOR per thread
+  zobrist_hasht h = l2->l2_state_hash;
+  for (size_t tid = 0; tid < threads_state.size(); tid++)
+    h ^= zobrist_hasht::key(tid, threads_state[tid].source.pc->location_number);
 
   return h;
 }
 
-crypto_hash execution_statet::update_hash_for_assignment(const expr2tc &rhs)
-{
-  crypto_hash h;
-  rhs->hash(h);
-  h.fin();
-  return h;
-}
-
 void execution_statet::print_stack_traces(unsigned int indent) const
 {
   std::vector<goto_symex_statet>::const_iterator it;
@@ -1353,38 +1335,26 @@ void execution_statet::state_hashing_level2t::make_assignment(
   const expr2tc &const_value,
   const expr2tc &assigned_value)
 {
-  //  crypto_hash hash;
-
   renaming::level2t::make_assignment(lhs_sym, const_value, assigned_value);
 
   // If there's no body to the assignment, don't hash.
   if (!is_nil_expr(assigned_value))
   {
     // XXX - consider whether to use l1 names instead. Recursion, reentrancy.
-    crypto_hash hash = owner->update_hash_for_assignment(assigned_value);
-    std::string orig_name = to_symbol2t(lhs_sym).thename.as_string();
-    current_hashes[orig_name] = hash;
+    // Equal keys make states be pruned as already explored, so the value is
+    // identified by a cryptographic hash rather than by its crc, which is
+    // cheaper but may collide.
+    const irep_idt &orig_name = to_symbol2t(lhs_sym).thename;
+    crypto_hash value_hash;
+    assigned_value->hash(value_hash);
+    value_hash.fin();
+    zobrist_hasht key = zobrist_hasht::key(
+      irep_id_hash()(orig_name),
+      value_hash.hash,
+      sizeof(value_hash.hash));
+
+    zobrist_hasht &current = current_hashes[orig_name];
+    l2_state_hash ^= current ^ key;
+    current = key;
   }
 }
-
-crypto_hash
-execution_statet::state_hashing_level2t::generate_l2_state_hash() const
-{
-  unsigned int total;
-  size_t hash_sz = sizeof(crypto_hash::hash);
-
-  uint8_t *data =
-    (uint8_t *)alloca(current_hashes.size() * hash_sz * sizeof(uint8_t));
-
-  total = 0;
-  for (const auto &current_hashe : current_hashes)
-  {
-    memcpy(&data[total * hash_sz], current_hashe.second.hash, hash_sz);
-    total++;
-  }
-
-  crypto_hash c;
-  c.ingest(data, total * hash_sz);
-  c.fin();
-  return c;
-}
@@ -14,6 +14,7 @@
 #include <irep2/irep2.h>
 #include <util/message.h>
 #include <util/std_expr.h>
+#include <util/zobrist_hash.h>
 
 class reachability_treet;
 
@@ -121,8 +122,13 @@ public:
       expr2tc &lhs_symbol,
       const expr2tc &const_value,
       const expr2tc &assigned_value) override;
-    crypto_hash generate_l2_state_hash() const;
-    typedef std::map<irep_idt, crypto_hash> current_state_hashest;
+    /// XOR of the keys of every variable's current value, updated on each
+    /// assignment
+    zobrist_hasht l2_state_hash;
+    /// Key of each variable's current value, to remove it from
+    /// l2_state_hash when the variable is assigned again
+    typedef persistent_mapt<irep_idt, zobrist_hasht, irep_id_hash>
+      current_state_hashest;
     current_state_hashest current_hashes;
   };
 
@@ -448,20 +454,13 @@ public:
 
   /**
    *  Generate hash of entire execution state.
-   *  This takes all current symbolic assignments to variables contained in the
-   *  l2 renaming object, and their precomputed hashes, concatonates them with
-   *  the current program counter of each thread, and hashes that. This results
-   *  in a full hash of the current execution state.
+   *  This combines the hash of all current symbolic assignments to variables,
+   *  which the l2 renaming object keeps up to date on every assignment, with
+   *  the current program counter of each thread. This results in a full hash
+   *  of the current execution state, without walking over the state.
    *  @return Hash of entire current execution state.
    */
-  crypto_hash generate_hash() const;
-
-  /**
-   *  Generate hash of an expression.
-   *  @param rhs Expression to hash.
-   *  @return Hash of passed in expression.
-   */
-  crypto_hash update_hash_for_assignment(const expr2tc &rhs);
+  zobrist_hasht generate_hash() const;
 
   /**
    *  Print stack trace of each thread to stdout.
@@ -466,6 +466,63 @@ protected:
     reachability_treet &art,
     const code_function_call2t &func_call);
 
+  /**
+   * @brief Intrinsic calls for C memcpy and memmove
+   *
+   * When both pointers are known to point into a single array of bytes
+   * and the number of bytes is constant, the copy is one assignment of
+   * the destination array. Otherwise the byte loop of the operational
+   * model in string.c is called.
+   *
+   * @param art
+   * @param func_call memcpy or memmove function call
+   * @param impl name of the operational model to fall back to
+   */
+  void intrinsic_memcpy(
+    reachability_treet &art,
+    const code_function_call2t &func_call,
+    const std::string &impl);
+
+  /// Intrinsic call for C memcmp, compares in one expression like memcpy
+  void intrinsic_memcmp(
+    reachability_treet &art,
+    const code_function_call2t &func_call);
+
+  /// Intrinsic call for C strlen, computes it in one expression like memcpy
+  void intrinsic_strlen(
+    reachability_treet &art,
+    const code_function_call2t &func_call);
+
+  /// Object and constant offset a pointer points to, for the intrinsics
+  struct byte_arrayt
+  {
+    /// The object as it appears in the value set, to be assigned to
+    expr2tc lhs;
+    /// The renamed object, to be read from
+    expr2tc value;
+    /// Under which ptr points to it
+    expr2tc guard;
+    uint64_t offset;
+    uint64_t size;
+
+    /// Byte i from the offset
+    expr2tc byte(uint64_t i) const;
+  };
+
+  /** Finds the array ptr points to for the memory intrinsics
+   *
+   * Only succeeds when the value set has a single object for ptr, at a
+   * constant offset, and the object is an array of bytes of known size.
+   */
+  bool get_byte_array(const expr2tc &ptr, byte_arrayt &array);
+
+  /** Dereferences the first and last of num_of_bytes bytes at ptr, so that
+   * the usual pointer checks are made for an intrinsic accessing them */
+  void check_byte_range(
+    const expr2tc &ptr,
+    uint64_t num_of_bytes,
+    dereferencet::modet mode);
+
   // Function to call a symname function, in case where were not able to optimize it
   void
   bump_call(const code_function_call2t &func_call, const std::string &symname);
@@ -298,10 +298,11 @@ void renaming::level2t::make_assignment(
   assert(
     to_symbol2t(lhs_symbol).rlevel == symbol2t::level1 ||
     to_symbol2t(lhs_symbol).rlevel == symbol2t::level1_global);
-  valuet &entry = current_names[name_record(to_symbol2t(lhs_symbol))];
+  name_record rec(to_symbol2t(lhs_symbol));
+  rename(lhs_symbol, current_number(rec) + 1);
 
-  // This'll update entry beneath our feet; could re-engineer it in the future.
-  rename(lhs_symbol, entry.count + 1);
+  // Fetched after renaming, which updates the entry
+  valuet &entry = current_names[rec];
 
   symbol2t &symbol = to_symbol2t(lhs_symbol);
   symbol2t::renaming_level lev = (symbol.rlevel == symbol2t::level0 ||
@@ -1,17 +1,63 @@
 #include <goto-symex/slice.h>
 
 #include <util/prefix.h>
-static bool no_slice(const symbol2t &sym)
+#include <boost/functional/hash.hpp>
+
+slice_dependency_grapht::symbol_keyt::symbol_keyt(const symbol2t &sym)
+  : name(sym.thename.get_no()), lev(sym.rlevel)
 {
-  return config.no_slice_names.count(sym.thename.as_string()) ||
-         config.no_slice_ids.count(sym.get_symbol_name());
+  switch (sym.rlevel)
+  {
+  case symbol2t::level0:
+  case symbol2t::level1_global:
+    // Both are printed as the bare name
+    lev = symbol2t::level0;
+    break;
+  case symbol2t::level2:
+    node_num = sym.node_num;
+    l2_num = sym.level2_num;
+    [[fallthrough]];
+  case symbol2t::level1:
+    l1_num = sym.level1_num;
+    t_num = sym.thread_num;
+    break;
+  case symbol2t::level2_global:
+    node_num = sym.node_num;
+    l2_num = sym.level2_num;
+    break;
+  }
+
+  size_t seed = 0;
+  boost::hash_combine(seed, name);
+  boost::hash_combine(seed, lev);
+  boost::hash_combine(seed, l1_num);
+  boost::hash_combine(seed, t_num);
+  boost::hash_combine(seed, node_num);
+  boost::hash_combine(seed, l2_num);
+  hash = seed;
 }
 
-template <bool Add>
-bool symex_slicet::get_symbols(const expr2tc &expr)
+slice_dependency_grapht::slice_dependency_grapht(
+  const symex_target_equationt::SSA_stepst &eq)
+  : steps(eq.size())
 {
-  bool res = false;
+  for (size_t i = 0; i < eq.size(); i++)
+    describe(eq[i], steps[i]);
+}
 
+unsigned slice_dependency_grapht::symbol_id(const symbol2t &sym)
+{
+  auto [it, inserted] = ids.emplace(symbol_keyt(sym), no_slice.size());
+  if (inserted)
+    no_slice.push_back(
+      config.no_slice_names.count(sym.thename.as_string()) ||
+      (!config.no_slice_ids.empty() &&
+       config.no_slice_ids.count(sym.get_symbol_name())));
+  return it->second;
+}
+
+void slice_dependency_grapht::get_uses(const expr2tc &expr, slice_usest &uses)
+{
   /* Array slicer, extract dependencies of the form arr_symbol[constant_index]
      Needs to come before the symbols as it short circuits.
      This should be safe as if some symbolic index is eventually added, it will go to the next case. So the full symbol will go to the dependency tree
@@ -23,51 +69,157 @@ bool symex_slicet::get_symbols(const expr2tc &expr)
       is_symbol2t(index.source_value) && is_constant_number(index.index) &&
       !to_constant_int2t(index.index).value.is_negative())
     {
-      const symbol2t &s = to_symbol2t(index.source_value);
-      const constant_int2t &i = to_constant_int2t(index.index);
-      if constexpr (Add)
-        return indexes[s.get_symbol_name()].insert(i.as_ulong()).second;
+      uses.elements.emplace_back(
+        symbol_id(to_symbol2t(index.source_value)),
+        to_constant_int2t(index.index).as_ulong());
+      return;
     }
   }
 
   // Recursively look if any of the operands has a inner symbol
-  expr->foreach_operand([this, &res](const expr2tc &e) {
+  expr->foreach_operand([this, &uses](const expr2tc &e) {
     if (!is_nil_expr(e))
-      res |= get_symbols<Add>(e);
-    return res;
+      get_uses(e, uses);
   });
 
-  if (!is_symbol2t(expr))
-    return res;
+  if (is_symbol2t(expr))
+    uses.symbols.push_back(symbol_id(to_symbol2t(expr)));
+}
 
-  const symbol2t &s = to_symbol2t(expr);
-  if constexpr (Add)
-    res |= depends.insert(s.get_symbol_name()).second;
-  else
-    res |= no_slice(s) || depends.find(s.get_symbol_name()) != depends.end();
-  return res;
+void slice_dependency_grapht::describe(
+  const symex_target_equationt::SSA_stept &step,
+  stept &deps)
+{
+  deps.guard.clear();
+  deps.cond.clear();
+  deps.rhs.clear();
+  deps.update_value.clear();
+  deps.is_array_update = false;
+
+  switch (step.type)
+  {
+  case goto_trace_stept::ASSERT:
+  case goto_trace_stept::ASSUME:
+    get_uses(step.guard, deps.guard);
+    get_uses(step.cond, deps.cond);
+    break;
+
+  case goto_trace_stept::ASSIGNMENT:
+  {
+    deps.lhs = symbol_id(to_symbol2t(step.lhs));
+    get_uses(step.guard, deps.guard);
+    get_uses(step.rhs, deps.rhs);
+
+    // WITH(symbol[constant_index] := constant_value)
+    if (
+      is_with2t(step.rhs) && is_symbol2t(to_with2t(step.rhs).source_value) &&
+      is_constant_int2t(to_with2t(step.rhs).update_field) &&
+      !to_constant_int2t(to_with2t(step.rhs).update_field).value.is_negative())
+    {
+      const with2t &with = to_with2t(step.rhs);
+      deps.is_array_update = true;
+      deps.update_source = symbol_id(to_symbol2t(with.source_value));
+      deps.update_index = to_constant_int2t(with.update_field).as_ulong();
+      get_uses(with.update_value, deps.update_value);
+    }
+    break;
+  }
+
+  case goto_trace_stept::RENUMBER:
+    deps.lhs = symbol_id(to_symbol2t(step.lhs));
+    break;
+
+  default:
+    break;
+  }
+}
+
+void symex_slicet::add_symbols(const slice_usest &uses)
+{
+  for (unsigned id : uses.symbols)
+  {
+    if (id >= depends.size())
+      depends.resize(id + 1);
+    depends[id] = true;
+  }
+
+  for (const auto &[id, index] : uses.elements)
+    indexes[id].insert(index);
+}
+
+bool symex_slicet::has_dependency(unsigned id) const
+{
+  return (id < depends.size() && depends[id]) || ids->is_no_slice(id);
+}
+
+bool symex_slicet::has_dependency(const slice_usest &uses) const
+{
+  for (unsigned id : uses.symbols)
+    if (has_dependency(id))
+      return true;
+
+  for (const auto &element : uses.elements)
+    if (has_dependency(element.first))
+      return true;
+
+  return false;
 }
 
 void symex_slicet::run_on_assert(symex_target_equationt::SSA_stept &SSA_step)
 {
-  get_symbols<true>(SSA_step.guard);
-  get_symbols<true>(SSA_step.cond);
+  graph.describe(SSA_step, deps);
+  add_symbols(deps.guard);
+  add_symbols(deps.cond);
 }
 
 void symex_slicet::run_on_assume(symex_target_equationt::SSA_stept &SSA_step)
 {
-  if (!slice_assumes)
+  graph.describe(SSA_step, deps);
+  if (!assume_needed(SSA_step, deps))
   {
-    get_symbols<true>(SSA_step.guard);
-    get_symbols<true>(SSA_step.cond);
-    return;
+    SSA_step.ignore = true;
+    ++sliced;
   }
+}
 
-  if (!get_symbols<false>(SSA_step.cond))
+void symex_slicet::run_on_assignment(
+  symex_target_equationt::SSA_stept &SSA_step)
+{
+  graph.describe(SSA_step, deps);
+  expr2tc new_cond;
+  if (!assignment_needed(SSA_step, deps, new_cond))
   {
-    // we don't really need it
     SSA_step.ignore = true;
     ++sliced;
+  }
+  else if (!is_nil_expr(new_cond))
+    SSA_step.cond = new_cond;
+}
+
+void symex_slicet::run_on_renumber(symex_target_equationt::SSA_stept &SSA_step)
+{
+  graph.describe(SSA_step, deps);
+  if (!renumber_needed(SSA_step, deps))
+  {
+    SSA_step.ignore = true;
+    ++sliced;
+  }
+}
+
+bool symex_slicet::assume_needed(
+  const symex_target_equationt::SSA_stept &SSA_step,
+  const slice_dependency_grapht::stept &deps)
+{
+  if (!slice_assumes)
+  {
+    add_symbols(deps.guard);
+    add_symbols(deps.cond);
+    return true;
+  }
+
+  if (!has_dependency(deps.cond))
+  {
+    // we don't really need it
     if (is_symbol2t(SSA_step.cond))
       log_debug(
         "slice",
@@ -75,22 +227,24 @@ void symex_slicet::run_on_assume(symex_target_equationt::SSA_stept &SSA_step)
         to_symbol2t(SSA_step.cond).get_symbol_name());
     else
       log_debug("slice", "slice ignoring assume expression");
+    return false;
   }
-  else
-  {
-    // If we need it, add the symbols to dependency
-    get_symbols<true>(SSA_step.guard);
-    get_symbols<true>(SSA_step.cond);
-  }
+
+  // If we need it, add the symbols to dependency
+  add_symbols(deps.guard);
+  add_symbols(deps.cond);
+  return true;
 }
 
-void symex_slicet::run_on_assignment(
-  symex_target_equationt::SSA_stept &SSA_step)
+bool symex_slicet::assignment_needed(
+  const symex_target_equationt::SSA_stept &SSA_step,
+  const slice_dependency_grapht::stept &deps,
+  expr2tc &new_cond)
 {
   assert(is_symbol2t(SSA_step.lhs));
   // TODO: create an option to ignore nondet symbols (test case generation)
 
-  if (!get_symbols<false>(SSA_step.lhs))
+  if (!has_dependency(deps.lhs))
   {
     // Should we add nondet to the dependency list (mostly for test cases)?
     if (!slice_nondet)
@@ -100,98 +254,178 @@ void symex_slicet::run_on_assignment(
       {
         auto &sym = to_symbol2t(expr);
         if (has_prefix(sym.thename.as_string(), "nondet$"))
-          return;
+          return true;
       }
     }
 
-    const symbol2t &lhs = to_symbol2t(SSA_step.lhs);
-    auto it = indexes.find(lhs.get_symbol_name());
-    // WITH(symbol[constant_index] := constant_value)
-    if (
-      is_with2t(SSA_step.rhs) &&
-      is_symbol2t(to_with2t(SSA_step.rhs).source_value) &&
-      is_constant_int2t(to_with2t(SSA_step.rhs).update_field) &&
-      !to_constant_int2t(to_with2t(SSA_step.rhs).update_field)
-         .value.is_negative())
+    auto it = indexes.find(deps.lhs);
+    if (deps.is_array_update)
     {
-      const with2t &with = to_with2t(SSA_step.rhs);
-      const symbol2t &rhs_symbol = to_symbol2t(with.source_value);
-      const constant_int2t &rhs_index = to_constant_int2t(with.update_field);
-
       // Is lhs in the watch list?
       if (it != indexes.end())
       {
         // Found an array in the dependency list! Its guard should be added to the dependency list
-        get_symbols<true>(SSA_step.guard);
+        add_symbols(deps.guard);
+
+        // Copy, inserting the source may rehash the map
+        std::unordered_set<size_t> watched = it->second;
 
         // Is this updating a watched index?
-        if (it->second.count(rhs_index.as_ulong()) > 0)
+        if (watched.erase(deps.update_index) > 0)
         {
           // Add next array as a dependency and remove one index.
-          indexes[rhs_symbol.get_symbol_name()] = it->second;
-          indexes[rhs_symbol.get_symbol_name()].erase(rhs_index.as_ulong());
+          indexes[deps.update_source] = std::move(watched);
 
           // Finally, the update_value becomes a dependency as well
-          get_symbols<true>(with.update_value);
+          add_symbols(deps.update_value);
         }
         else
         {
+          const with2t &with = to_with2t(SSA_step.rhs);
           log_debug(
             "slice",
             "slice ignoring update to array {} at index {}",
-            rhs_symbol.get_symbol_name(),
-            rhs_index.as_ulong());
+            to_symbol2t(with.source_value).get_symbol_name(),
+            deps.update_index);
           // Don't need the update, transform into ID and propagate dependences
-          SSA_step.cond = equality2tc(SSA_step.lhs, with.source_value);
-          indexes[rhs_symbol.get_symbol_name()] = it->second;
+          new_cond = equality2tc(SSA_step.lhs, with.source_value);
+          indexes[deps.update_source] = std::move(watched);
         }
-        return;
+        return true;
       }
     }
 
     // We might be trying to initialize an array in a weird way
     if (it != indexes.end())
     {
-      get_symbols<true>(SSA_step.guard);
-      get_symbols<true>(SSA_step.rhs);
-      return;
+      add_symbols(deps.guard);
+      add_symbols(deps.rhs);
+      return true;
     }
 
     // we don't really need it
-    SSA_step.ignore = true;
-    ++sliced;
     log_debug(
       "slice",
       "slice ignoring assignment to symbol {}",
       to_symbol2t(SSA_step.lhs).get_symbol_name());
+    return false;
   }
-  else
-  {
-    get_symbols<true>(SSA_step.guard);
-    get_symbols<true>(SSA_step.rhs);
 
-    // Remove this symbol as we won't be seeing any references to it further
-    // into the history.
-    depends.erase(to_symbol2t(SSA_step.lhs).get_symbol_name());
-  }
+  add_symbols(deps.guard);
+  add_symbols(deps.rhs);
+
+  // Remove this symbol as we won't be seeing any references to it further
+  // into the history.
+  if (deps.lhs < depends.size())
+    depends[deps.lhs] = false;
+  return true;
 }
 
-void symex_slicet::run_on_renumber(symex_target_equationt::SSA_stept &SSA_step)
+bool symex_slicet::renumber_needed(
+  const symex_target_equationt::SSA_stept &SSA_step,
+  const slice_dependency_grapht::stept &deps)
 {
   assert(is_symbol2t(SSA_step.lhs));
 
-  if (!get_symbols<false>(SSA_step.lhs))
+  // Don't collect the symbol; this insn has no effect on dependencies.
+  if (!has_dependency(deps.lhs))
   {
     // we don't really need it
-    SSA_step.ignore = true;
-    ++sliced;
     log_debug(
       "slice",
       "slice ignoring renumbering symbol {}",
       to_symbol2t(SSA_step.lhs).get_symbol_name());
+    return false;
   }
 
-  // Don't collect the symbol; this insn has no effect on dependencies.
+  return true;
+}
+
+void symex_slicet::run_on_claim(
+  const slice_dependency_grapht &shared_graph,
+  const symex_target_equationt::SSA_stepst &eq,
+  symex_target_equationt::SSA_stepst::const_iterator claim,
+  symex_target_equationt::SSA_stepst &sliced_eq)
+{
+  fine_timet algorithm_start = current_time();
+  slice_claim(shared_graph, eq, claim, &sliced_eq);
+  fine_timet algorithm_stop = current_time();
+  log_status(
+    "Slicing time: {}s (removed {} assignments)",
+    time2string(algorithm_stop - algorithm_start),
+    sliced);
+}
+
+size_t symex_slicet::claim_size(
+  const slice_dependency_grapht &shared_graph,
+  const symex_target_equationt::SSA_stepst &eq,
+  symex_target_equationt::SSA_stepst::const_iterator claim)
+{
+  return slice_claim(shared_graph, eq, claim, nullptr);
+}
+
+size_t symex_slicet::slice_claim(
+  const slice_dependency_grapht &shared_graph,
+  const symex_target_equationt::SSA_stepst &eq,
+  symex_target_equationt::SSA_stepst::const_iterator claim,
+  symex_target_equationt::SSA_stepst *sliced_eq)
+{
+  sliced = 0;
+  ids = &shared_graph;
+  depends.assign(shared_graph.num_symbols(), false);
+  indexes.clear();
+
+  size_t kept = 0;
+  // Nothing after the claim can influence it
+  for (size_t i = claim - eq.begin() + 1; i-- > 0;)
+  {
+    const symex_target_equationt::SSA_stept &step = eq[i];
+    const slice_dependency_grapht::stept &step_deps = shared_graph[i];
+    bool is_claim = &step == &*claim;
+
+    // Every other claim is dropped, as claim_slicer would do
+    if (!is_claim && (step.ignore || step.is_assert()))
+      continue;
+
+    bool needed = true;
+    expr2tc new_cond;
+    switch (step.type)
+    {
+    case goto_trace_stept::ASSIGNMENT:
+      needed = assignment_needed(step, step_deps, new_cond);
+      break;
+    case goto_trace_stept::ASSUME:
+      needed = assume_needed(step, step_deps);
+      break;
+    case goto_trace_stept::ASSERT:
+      add_symbols(step_deps.guard);
+      add_symbols(step_deps.cond);
+      break;
+    case goto_trace_stept::RENUMBER:
+      needed = renumber_needed(step, step_deps);
+      break;
+    default:
+      break;
+    }
+
+    if (!needed)
+    {
+      ++sliced;
+      continue;
+    }
+
+    ++kept;
+    if (!sliced_eq)
+      continue;
+
+    sliced_eq->push_front(step);
+    sliced_eq->front().ignore = false;
+    if (!is_nil_expr(new_cond))
+      sliced_eq->front().cond = new_cond;
+  }
+
+  ids = &graph;
+  return kept;
 }
 
 /**
@@ -231,6 +465,20 @@ bool simple_slice::run(symex_target_equationt::SSA_stepst &steps)
   return true;
 }
 
+void claim_slicer::set_claim_info(
+  const symex_target_equationt::SSA_stept &step)
+{
+  if (!is_goto_cov)
+    // obtain the guard info from the assertions
+    claim_msg = from_expr(ns, "", step.source.pc->guard);
+  else
+    // in goto-coverage mode, the assertions are converted to assert(0）
+    // the original guards are stored in comment.
+    claim_msg = step.comment();
+  claim_loc = step.source.pc->location.as_string();
+  claim_cstr = step.comment() + " at " + claim_loc;
+}
+
 bool claim_slicer::run(symex_target_equationt::SSA_stepst &steps)
 {
   sliced = 0;
@@ -248,15 +496,7 @@ bool claim_slicer::run(symex_target_equationt::SSA_stepst &steps)
         claim_to_keep) // this is the assertion that we should not skip!
       {
         it->ignore = false;
-        if (!is_goto_cov)
-          // obtain the guard info from the assertions
-          claim_msg = from_expr(ns, "", it->source.pc->guard);
-        else
-          // in goto-coverage mode, the assertions are converted to assert(0）
-          // the original guards are stored in comment.
-          claim_msg = it->comment;
-        claim_loc = it->source.pc->location.as_string();
-        claim_cstr = it->comment + " at " + claim_loc;
+        set_claim_info(*it);
         continue;
       }
 
@@ -280,6 +520,36 @@ bool claim_slicer::run(symex_target_equationt::SSA_stepst &steps)
 
   return true;
 }
+
+symex_target_equationt::SSA_stepst::const_iterator
+claim_slicer::find_claim(const symex_target_equationt::SSA_stepst &steps)
+{
+  size_t counter = 1;
+  for (auto it = steps.begin(); it != steps.end(); it++)
+    if (it->is_assert() && counter++ == claim_to_keep)
+    {
+      set_claim_info(*it);
+      return it;
+    }
+
+  return steps.end();
+}
+
+void claim_slicer::copy_claim(
+  const symex_target_equationt::SSA_stepst &steps,
+  symex_target_equationt::SSA_stepst::const_iterator claim,
+  symex_target_equationt::SSA_stepst &claim_steps) const
+{
+  for (auto it = steps.begin(); it != steps.end(); it++)
+  {
+    if (it != claim && (it->ignore || it->is_assert()))
+      continue;
+
+    claim_steps.push_back(*it);
+    claim_steps.back().ignore = false;
+  }
+}
+
 // Recursively try to extract the nondet symbol of an expression
 expr2tc symex_slicet::get_nondet_symbol(const expr2tc &expr)
 {
@@ -61,6 +61,25 @@ public:
     }
   };
   bool run(symex_target_equationt::SSA_stepst &) override;
+
+  /**
+   * Locates the claim to keep without modifying the formula and fills in
+   * the claim information (message, location, ...).
+   *
+   * @return the assertion of the claim or steps.end() if there is none
+   */
+  symex_target_equationt::SSA_stepst::const_iterator
+  find_claim(const symex_target_equationt::SSA_stepst &steps);
+
+  /**
+   * Copies into \claim_steps the steps of \steps that remain after claim
+   * slicing, leaving \steps untouched. Ignored steps are not copied.
+   */
+  void copy_claim(
+    const symex_target_equationt::SSA_stepst &steps,
+    symex_target_equationt::SSA_stepst::const_iterator claim,
+    symex_target_equationt::SSA_stepst &claim_steps) const;
+
   size_t claim_to_keep;
   std::string claim_msg;
   std::string claim_loc;
@@ -68,6 +87,118 @@ public:
   bool show_slice_info;
   bool is_goto_cov;
   namespacet ns;
+
+protected:
+  void set_claim_info(const symex_target_equationt::SSA_stept &step);
+};
+
+/**
+ * Symbols and array elements an expression depends on for the symex
+ * slicer, as ids of a slice_dependency_grapht.
+ */
+struct slice_usest
+{
+  /// symbols read by the expression
+  std::vector<unsigned> symbols;
+  /// elements arr[i] read with a constant index, arr itself is only here
+  std::vector<std::pair<unsigned, size_t>> elements;
+
+  void clear()
+  {
+    symbols.clear();
+    elements.clear();
+  }
+};
+
+/**
+ * @brief Symbol dependencies of the steps of an SSA formula, the input of
+ * the symex-slicer
+ *
+ * Every renamed symbol gets a dense id: two symbols have the same id when
+ * they have the same get_symbol_name(), but the name is never built. The
+ * graph of a formula can be computed once and then used to slice it for
+ * every claim, see symex_slicet::run_on_claim.
+ */
+class slice_dependency_grapht
+{
+public:
+  struct stept
+  {
+    /// symbol assigned or renumbered
+    unsigned lhs = 0;
+    slice_usest guard, cond, rhs;
+
+    /// WITH(symbol[constant_index] := update_value) assignments
+    bool is_array_update = false;
+    unsigned update_source = 0;
+    size_t update_index = 0;
+    slice_usest update_value;
+  };
+
+  slice_dependency_grapht() = default;
+
+  /// Computes the dependencies of every step of \steps
+  explicit slice_dependency_grapht(
+    const symex_target_equationt::SSA_stepst &steps);
+
+  /// Dependencies of the \i-th step of the formula the graph was built from
+  const stept &operator[](size_t i) const
+  {
+    return steps[i];
+  }
+
+  /// Computes the dependencies of a single step, adding its symbols
+  void describe(const symex_target_equationt::SSA_stept &step, stept &deps);
+
+  unsigned symbol_id(const symbol2t &sym);
+
+  size_t num_symbols() const
+  {
+    return no_slice.size();
+  }
+
+  /// Whether the user asked for the symbol never to be sliced away
+  bool is_no_slice(unsigned id) const
+  {
+    return no_slice[id];
+  }
+
+protected:
+  class symbol_keyt
+  {
+  public:
+    explicit symbol_keyt(const symbol2t &sym);
+
+    bool operator==(const symbol_keyt &ref) const
+    {
+      return name == ref.name && lev == ref.lev && l1_num == ref.l1_num &&
+             t_num == ref.t_num && node_num == ref.node_num &&
+             l2_num == ref.l2_num;
+    }
+
+    // Only the parts of the symbol that get_symbol_name() prints are set
+    unsigned name;
+    uint8_t lev;
+    unsigned l1_num = 0;
+    unsigned t_num = 0;
+    unsigned node_num = 0;
+    unsigned l2_num = 0;
+    size_t hash;
+  };
+
+  struct symbol_key_hash
+  {
+    size_t operator()(const symbol_keyt &key) const
+    {
+      return key.hash;
+    }
+  };
+
+  std::unordered_map<symbol_keyt, unsigned, symbol_key_hash> ids;
+  std::vector<bool> no_slice;
+  std::vector<stept> steps;
+
+  void get_uses(const expr2tc &expr, slice_usest &uses);
 };
 
 /**
@@ -115,13 +246,39 @@ public:
   }
 
   /**
-   * Holds the symbols the current equation depends on.
+   * Slices \eq for a single claim without modifying it: the steps needed by
+   * the \claim assertion are copied into \sliced_eq, while every other
+   * claim and every step that was sliced away is never copied. This allows
+   * many claims to be sliced concurrently from one shared equation.
+   *
+   * @param graph dependencies of \eq, shared between claims
+   * @param eq symex formula shared between claims
+   * @param claim the assertion to keep, e.g. from claim_slicer::find_claim
+   * @param sliced_eq receives the sliced formula of the claim
    */
-  std::unordered_set<std::string> depends;
+  void run_on_claim(
+    const slice_dependency_grapht &graph,
+    const symex_target_equationt::SSA_stepst &eq,
+    symex_target_equationt::SSA_stepst::const_iterator claim,
+    symex_target_equationt::SSA_stepst &sliced_eq);
+
+  /**
+   * Number of steps run_on_claim() would copy for \claim, computed without
+   * copying them. This is the size of the claim's formula after slicing.
+   */
+  size_t claim_size(
+    const slice_dependency_grapht &graph,
+    const symex_target_equationt::SSA_stepst &eq,
+    symex_target_equationt::SSA_stepst::const_iterator claim);
+
+  /**
+   * Holds the ids of the symbols the current equation depends on.
+   */
+  std::vector<bool> depends;
 
   /**
  * Hold a map of array symbols and indexes. All other indexes can be cut */
-  std::unordered_map<std::string, std::unordered_set<size_t>> indexes;
+  std::unordered_map<unsigned, std::unordered_set<size_t>> indexes;
 
   static expr2tc get_nondet_symbol(const expr2tc &expr);
 
@@ -155,16 +312,37 @@ protected:
   /// Whether we should slice nondet symbols
   const bool slice_nondet;
 
+  /// symbol ids of the steps visited by run()
+  slice_dependency_grapht graph;
+  /// the graph whose ids are in #depends and #indexes
+  const slice_dependency_grapht *ids = &graph;
+  /// dependencies of the step being visited by run()
+  slice_dependency_grapht::stept deps;
+
   /**
-   * Recursively explores the operands of an expression \expr
-   * If a symbol is found, then it is added into the #depends
-   * member if `Add` is true, otherwise returns true.
+   * Backward pass of run_on_claim() and claim_size(): the steps needed by
+   * \claim are copied into \sliced_eq, if given.
    *
-   * @param expr expression to extract every symbol
-   * @return true if at least one symbol was found
+   * @return the number of steps needed by \claim
+   */
+  size_t slice_claim(
+    const slice_dependency_grapht &shared_graph,
+    const symex_target_equationt::SSA_stepst &eq,
+    symex_target_equationt::SSA_stepst::const_iterator claim,
+    symex_target_equationt::SSA_stepst *sliced_eq);
+
+  /**
+   * Adds the symbols and array elements of \uses into the #depends and
+   * #indexes.
+   */
+  void add_symbols(const slice_usest &uses);
+
+  /**
+   * @return true if one of the symbols of \uses is in the #depends or must
+   * not be sliced
    */
-  template <bool Add>
-  bool get_symbols(const expr2tc &expr);
+  bool has_dependency(const slice_usest &uses) const;
+  bool has_dependency(unsigned id) const;
 
   /**
    * Remove unneeded assumes from the formula
@@ -229,6 +407,26 @@ protected:
    * @param SSA_step an renumber step
    */
   void run_on_renumber(symex_target_equationt::SSA_stept &SSA_step) override;
+
+  /**
+   * The decisions behind run_on_assume(), run_on_assignment() and
+   * run_on_renumber(): they update the #depends from the dependencies
+   * \deps of the step and tell whether the step is needed, without
+   * modifying it.
+   *
+   * @param new_cond set when the assignment is only needed as the identity
+   * of an array whose updated index is not a dependency
+   */
+  bool assume_needed(
+    const symex_target_equationt::SSA_stept &SSA_step,
+    const slice_dependency_grapht::stept &deps);
+  bool assignment_needed(
+    const symex_target_equationt::SSA_stept &SSA_step,
+    const slice_dependency_grapht::stept &deps,
+    expr2tc &new_cond);
+  bool renumber_needed(
+    const symex_target_equationt::SSA_stept &SSA_step,
+    const slice_dependency_grapht::stept &deps);
 };
 
 #endif
@@ -318,8 +318,10 @@ void goto_symext::phi_function(const statet::goto_statet &goto_state)
   if (goto_state.guard.is_false() && cur_state->guard.is_false())
     return;
 
-  // go over all variables to see what changed
-  const auto &variables = cur_state->level2.current_names;
+  // go over all variables to see what changed. This is a copy: the
+  // assignments below modify the current names, and both maps still share
+  // whatever didn't change since the branch, which the walk skips.
+  const auto variables = cur_state->level2.current_names;
 
   const auto &goto_variables = goto_state.level2.current_names;
 
@@ -334,75 +336,75 @@ void goto_symext::phi_function(const statet::goto_statet &goto_state)
     tmp_guard -= cur_state->guard;
   }
 
-  for (const auto &[variable, _] : variables)
-  {
-    if (
-      goto_state.level2.current_number(variable) ==
-      cur_state->level2.current_number(variable))
-      continue; // not changed
+  variables.for_each_difference(
+    goto_variables, [&](const auto &entry, const auto *goto_value) {
+      const renaming::level2t::name_record &variable = entry.first;
 
-    if (variable.base_name == guard_identifier_s)
-      continue; // just a guard
+      // If the variable was deleted in this branch, don't create an assignment
+      // for it
+      if (goto_value == nullptr)
+        return;
 
-    if (has_prefix(variable.base_name.as_string(), "symex::invalid_object"))
-      continue;
+      if (goto_value->count == entry.second.count)
+        return; // not changed
 
-    // If the variable was deleted in this branch, don't create an assignment
-    // for it
-    if (goto_variables.find(variable) == goto_variables.end())
-      continue;
+      if (variable.base_name == guard_identifier_s)
+        return; // just a guard
 
-    // changed!
-    const symbolt &symbol = *ns.lookup(variable.base_name);
+      if (has_prefix(variable.base_name.as_string(), "symex::invalid_object"))
+        return;
 
-    type2tc type = migrate_type(symbol.type);
+      // changed!
+      const symbolt &symbol = *ns.lookup(variable.base_name);
 
-    expr2tc cur_state_rhs = symbol2tc(type, symbol.id);
-    renaming::level2t::rename_to_record(cur_state_rhs, variable);
+      type2tc type = migrate_type(symbol.type);
 
-    expr2tc goto_state_rhs = symbol2tc(type, symbol.id);
-    renaming::level2t::rename_to_record(goto_state_rhs, variable);
+      expr2tc cur_state_rhs = symbol2tc(type, symbol.id);
+      renaming::level2t::rename_to_record(cur_state_rhs, variable);
 
-    expr2tc rhs;
-    // Semi-manually rename these symbols: we may be referring to an l1
-    // variable not in the current scope, thus we need to directly specify
-    // which l1 variable we're dealing with.
-    goto_state.level2.rename(goto_state_rhs);
-    if (cur_state->guard.is_false())
-      rhs = goto_state_rhs;
+      expr2tc goto_state_rhs = symbol2tc(type, symbol.id);
+      renaming::level2t::rename_to_record(goto_state_rhs, variable);
 
-    cur_state->level2.rename(cur_state_rhs);
-    if (goto_state.guard.is_false())
-      rhs = cur_state_rhs;
-    else
-    {
-      rhs = if2tc(type, tmp_guard.as_expr(), goto_state_rhs, cur_state_rhs);
-      simplify(rhs);
-    }
+      expr2tc rhs;
+      // Semi-manually rename these symbols: we may be referring to an l1
+      // variable not in the current scope, thus we need to directly specify
+      // which l1 variable we're dealing with.
+      goto_state.level2.rename(goto_state_rhs);
+      if (cur_state->guard.is_false())
+        rhs = goto_state_rhs;
 
-    expr2tc lhs;
-    migrate_expr(symbol_expr(symbol), lhs);
-    expr2tc new_lhs = lhs;
-
-    // Again, specify which l1 data object we're going to make the assignment
-    // to.
-    renaming::level2t::rename_to_record(new_lhs, variable);
-
-    cur_state->rename_type(new_lhs);
-    cur_state->rename_type(rhs);
-    cur_state->assignment(new_lhs, rhs);
-
-    target->assignment(
-      gen_true_expr(),
-      new_lhs,
-      lhs,
-      rhs,
-      expr2tc(),
-      cur_state->source,
-      cur_state->gen_stack_trace(),
-      true,
-      first_loop);
-  }
+      cur_state->level2.rename(cur_state_rhs);
+      if (goto_state.guard.is_false())
+        rhs = cur_state_rhs;
+      else
+      {
+        rhs = if2tc(type, tmp_guard.as_expr(), goto_state_rhs, cur_state_rhs);
+        simplify(rhs);
+      }
+
+      expr2tc lhs;
+      migrate_expr(symbol_expr(symbol), lhs);
+      expr2tc new_lhs = lhs;
+
+      // Again, specify which l1 data object we're going to make the assignment
+      // to.
+      renaming::level2t::rename_to_record(new_lhs, variable);
+
+      cur_state->rename_type(new_lhs);
+      cur_state->rename_type(rhs);
+      cur_state->assignment(new_lhs, rhs);
+
+      target->assignment(
+        gen_true_expr(),
+        new_lhs,
+        lhs,
+        rhs,
+        expr2tc(),
+        cur_state->source,
+        cur_state->gen_stack_trace(),
+        true,
+        first_loop);
+    });
 }
 
 void goto_symext::loop_bound_exceeded(const expr2tc &guard)
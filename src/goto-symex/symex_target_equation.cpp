@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cassert>
 #include <goto-symex/goto_symex.h>
 #include <goto-symex/goto_symex_state.h>
@@ -32,22 +33,60 @@ void symex_target_equationt::assignment(
   SSA_steps.emplace_back();
   SSA_stept &SSA_step = SSA_steps.back();
 
-  SSA_step.guard = guard;
-  SSA_step.lhs = lhs;
+  SSA_step.guard = share(guard);
+  SSA_step.lhs = share(lhs);
   SSA_step.original_lhs = original_lhs;
   SSA_step.original_rhs = original_rhs;
-  SSA_step.rhs = rhs;
+  SSA_step.rhs = share(rhs);
   SSA_step.hidden = hidden;
-  SSA_step.cond = equality2tc(lhs, rhs);
+  SSA_step.cond = equality2tc(SSA_step.lhs, SSA_step.rhs);
   SSA_step.type = goto_trace_stept::ASSIGNMENT;
   SSA_step.source = source;
-  SSA_step.stack_trace = stack_trace;
   SSA_step.loop_number = loop_number;
 
+  if (!stack_trace.empty())
+  {
+    auto cold = std::make_shared<SSA_stept::cold_fieldst>();
+    cold->stack_trace = std::move(stack_trace);
+    SSA_step.cold = std::move(cold);
+  }
+
   if (debug_print)
     debug_print_step(SSA_step);
 }
 
+expr2tc symex_target_equationt::share(const expr2tc &expr)
+{
+  if (is_nil_expr(expr))
+    return expr;
+
+  // An equal expression was seen before: all of its subexpressions are
+  // already shared
+  auto it = shared_exprs.find(expr);
+  if (it != shared_exprs.end())
+    return *it;
+
+  std::vector<expr2tc> operands;
+  bool changed = false;
+  expr->foreach_operand([this, &operands, &changed](const expr2tc &op) {
+    const expr2tc &shared = operands.emplace_back(share(op));
+    changed |= shared.get() != op.get();
+  });
+
+  // Only copy the node if one of its operands was replaced; expr may also
+  // be referenced from the symex state
+  expr2tc result = expr;
+  if (changed)
+  {
+    size_t i = 0;
+    result.get()->Foreach_operand(
+      [&operands, &i](expr2tc &op) { op = operands[i++]; });
+  }
+
+  shared_exprs.insert(result);
+  return result;
+}
+
 void symex_target_equationt::output(
   const expr2tc &guard,
   const sourcet &source,
@@ -60,8 +99,11 @@ void symex_target_equationt::output(
   SSA_step.guard = guard;
   SSA_step.type = goto_trace_stept::OUTPUT;
   SSA_step.source = source;
-  SSA_step.output_args = args;
-  SSA_step.format_string = fmt;
+
+  auto cold = std::make_shared<SSA_stept::cold_fieldst>();
+  cold->output_args = args;
+  cold->format_string = fmt;
+  SSA_step.cold = std::move(cold);
 
   if (debug_print)
     debug_print_step(SSA_step);
@@ -101,10 +143,13 @@ void symex_target_equationt::assertion(
   SSA_step.cond = cond;
   SSA_step.type = goto_trace_stept::ASSERT;
   SSA_step.source = source;
-  SSA_step.comment = msg;
-  SSA_step.stack_trace = stack_trace;
   SSA_step.loop_number = loop_number;
 
+  auto cold = std::make_shared<SSA_stept::cold_fieldst>();
+  cold->comment = msg;
+  cold->stack_trace = std::move(stack_trace);
+  SSA_step.cold = std::move(cold);
+
   if (debug_print)
     debug_print_step(SSA_step);
 }
@@ -187,11 +232,8 @@ void symex_target_equationt::convert_internal_step(
   }
   else if (step.is_output())
   {
-    for (std::list<expr2tc>::const_iterator o_it = step.output_args.begin();
-         o_it != step.output_args.end();
-         o_it++)
+    for (const expr2tc &tmp : step.output_args())
     {
-      const expr2tc &tmp = *o_it;
       if (is_constant_expr(tmp) || is_constant_string2t(tmp))
         step.converted_output_args.push_back(tmp);
       else
@@ -295,7 +337,7 @@ void symex_target_equationt::SSA_stept::output(
     out << from_expr(ns, "", migrate_expr_back(cond)) << "\n";
 
   if (is_assert())
-    out << comment << "\n";
+    out << comment() << "\n";
 
   if (config.options.get_bool_option("ssa-guards"))
     out << "Guard: " << from_expr(ns, "", migrate_expr_back(guard)) << "\n";
@@ -365,16 +407,15 @@ unsigned int symex_target_equationt::clear_assertions()
 {
   unsigned int num_asserts = 0;
 
-  for (SSA_stepst::iterator it = SSA_steps.begin(); it != SSA_steps.end(); it++)
-  {
-    if (it->type == goto_trace_stept::ASSERT)
-    {
-      SSA_stepst::iterator it2 = it;
-      it--;
-      SSA_steps.erase(it2);
+  // Compact the remaining steps in a single pass
+  SSA_stepst::iterator new_end = std::remove_if(
+    SSA_steps.begin(), SSA_steps.end(), [&num_asserts](const SSA_stept &step) {
+      if (step.type != goto_trace_stept::ASSERT)
+        return false;
       num_asserts++;
-    }
-  }
+      return true;
+    });
+  SSA_steps.erase(new_end, SSA_steps.end());
 
   return num_asserts;
 }
@@ -421,7 +462,7 @@ runtime_encoded_equationt::runtime_encoded_equationt(
 {
   assert_vec_list.emplace_back();
   assumpt_chain.push_back(conv.convert_ast(gen_true_expr()));
-  cvt_progress = SSA_steps.end();
+  cvt_progress = 0;
 }
 
 void runtime_encoded_equationt::flush_latest_instructions()
@@ -429,34 +470,13 @@ void runtime_encoded_equationt::flush_latest_instructions()
   if (SSA_steps.size() == 0)
     return;
 
-  SSA_stepst::iterator run_it = cvt_progress;
-  // Scenarios:
-  // * We're at the start of running, in which case cvt_progress == end
-  // * We're in the middle, but nothing is left to push, so run_it + 1 == end
-  // * We're in the middle, and there's more to convert.
-  if (run_it == SSA_steps.end())
-  {
-    run_it = SSA_steps.begin();
-  }
-  else
-  {
-    run_it++;
-    if (run_it == SSA_steps.end())
-    {
-      // There is in fact, nothing to do
-      return;
-    }
-
-    // Just roll on
-  }
-
-  // Now iterate from the start insn to convert, to the end of the list.
-  for (; run_it != SSA_steps.end(); ++run_it)
+  // Iterate from the first unconverted insn to the end of the list.
+  for (; cvt_progress < SSA_steps.size(); ++cvt_progress)
     convert_internal_step(
-      conv, assumpt_chain.back(), assert_vec_list.back(), *run_it);
-
-  run_it--;
-  cvt_progress = run_it;
+      conv,
+      assumpt_chain.back(),
+      assert_vec_list.back(),
+      SSA_steps[cvt_progress]);
 }
 
 void runtime_encoded_equationt::push_ctx()
@@ -472,13 +492,8 @@ void runtime_encoded_equationt::push_ctx()
 
 void runtime_encoded_equationt::pop_ctx()
 {
-  SSA_stepst::iterator it = scoped_end_points.back();
-  cvt_progress = it;
-
-  if (SSA_steps.size() != 0)
-    ++it;
-
-  SSA_steps.erase(it, SSA_steps.end());
+  cvt_progress = scoped_end_points.back();
+  SSA_steps.erase(SSA_steps.begin() + cvt_progress, SSA_steps.end());
 
   conv.pop_ctx();
   scoped_end_points.pop_back();
@@ -511,7 +526,7 @@ std::shared_ptr<symex_targett> runtime_encoded_equationt::clone() const
     "cloned when it contains data");
   auto nthis = std::shared_ptr<runtime_encoded_equationt>(
     new runtime_encoded_equationt(*this));
-  nthis->cvt_progress = nthis->SSA_steps.end();
+  nthis->cvt_progress = 0;
   return nthis;
 }
 
@@ -4,15 +4,18 @@
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <deque>
 #include <goto-programs/goto_program.h>
 #include <goto-symex/goto_trace.h>
 #include <goto-symex/symex_target.h>
 #include <list>
 #include <map>
+#include <memory>
 #include <solvers/smt/smt_conv.h>
 #include <util/config.h>
 #include <irep2/irep2.h>
 #include <util/namespace.h>
+#include <unordered_set>
 #include <vector>
 
 class symex_target_equationt : public symex_targett
@@ -88,11 +91,6 @@ public:
     sourcet source;
     goto_trace_stept::typet type;
 
-    // One stack trace recorded per function activation record. Valid for
-    // assignment and assert steps only. In reverse order (most recent in idx
-    // 0).
-    std::vector<stack_framet> stack_trace;
-
     bool is_assert() const
     {
       return type == goto_trace_stept::ASSERT;
@@ -126,11 +124,6 @@ public:
 
     // for ASSUME/ASSERT
     expr2tc cond;
-    std::string comment;
-
-    // for OUTPUT
-    std::string format_string;
-    std::list<expr2tc> output_args;
 
     // for conversion
     smt_astt guard_ast, cond_ast;
@@ -145,6 +138,42 @@ public:
     // for bidirectional search
     unsigned loop_number;
 
+    // Fields that most steps leave empty live out of line, so that the steps
+    // stay small. They are set when the step is recorded and never change
+    // afterwards, copies of a step share them.
+    struct cold_fieldst
+    {
+      // One stack trace recorded per function activation record. Valid for
+      // assignment and assert steps only. In reverse order (most recent in
+      // idx 0).
+      std::vector<stack_framet> stack_trace;
+
+      // for ASSERT
+      std::string comment;
+
+      // for OUTPUT
+      std::string format_string;
+      std::list<expr2tc> output_args;
+    };
+    std::shared_ptr<const cold_fieldst> cold;
+
+    const std::vector<stack_framet> &stack_trace() const
+    {
+      return cold_fields().stack_trace;
+    }
+    const std::string &comment() const
+    {
+      return cold_fields().comment;
+    }
+    const std::string &format_string() const
+    {
+      return cold_fields().format_string;
+    }
+    const std::list<expr2tc> &output_args() const
+    {
+      return cold_fields().output_args;
+    }
+
     SSA_stept() : ignore(false), hidden(false)
     {
     }
@@ -155,6 +184,13 @@ public:
       std::ostream &out,
       bool show_ignored = false) const;
     void dump() const;
+
+  private:
+    const cold_fieldst &cold_fields() const
+    {
+      static const cold_fieldst none;
+      return cold ? *cold : none;
+    }
   };
 
   unsigned count_ignored_SSA_steps() const
@@ -166,18 +202,16 @@ public:
     return i;
   }
 
-  typedef std::list<SSA_stept> SSA_stepst;
+  // A deque keeps the steps in large blocks instead of one allocation per
+  // step, gives constant time access by index and, unlike a vector, does not
+  // move the steps when the equation grows at either end.
+  typedef std::deque<SSA_stept> SSA_stepst;
   SSA_stepst SSA_steps;
 
   SSA_stepst::iterator get_SSA_step(unsigned s)
   {
-    SSA_stepst::iterator it = SSA_steps.begin();
-    for (; s != 0; s--)
-    {
-      assert(it != SSA_steps.end());
-      it++;
-    }
-    return it;
+    assert(s <= SSA_steps.size());
+    return SSA_steps.begin() + s;
   }
 
   void output(std::ostream &out) const;
@@ -189,6 +223,7 @@ public:
   {
     SSA_steps.clear();
     output_count = 0;
+    shared_exprs.clear();
   }
 
   unsigned int clear_assertions();
@@ -197,7 +232,11 @@ public:
   {
     // No pointers or anything that requires ownership modification, can just
     // duplicate self.
-    return std::shared_ptr<symex_targett>(new symex_target_equationt(*this));
+    auto eq = std::shared_ptr<symex_target_equationt>(
+      new symex_target_equationt(*this));
+    // The copy starts sharing afresh, see share()
+    eq->shared_exprs.clear();
+    return eq;
   }
 
   void push_ctx() override;
@@ -211,6 +250,20 @@ protected:
   bool ssa_smt_trace;
   unsigned output_count;
 
+  /** Every distinct expression assigned so far, see share(). Unrolled loops
+   *  keep producing the same subexpressions; sharing one copy of each makes
+   *  the equation a DAG, so its crcs are computed once and comparing two
+   *  equal subexpressions in the solver's cache is a pointer comparison.
+   *  The set belongs to this equation alone: clear() empties it and clones
+   *  start with an empty one, so it never keeps the expressions of another
+   *  interleaving alive. */
+  typedef std::unordered_set<expr2tc, irep2_hash> shared_exprst;
+  shared_exprst shared_exprs;
+
+  /** Returns expr with every subexpression replaced by the equal one
+   *  recorded in shared_exprs, recording those that weren't there yet. */
+  expr2tc share(const expr2tc &expr);
+
 private:
   void debug_print_step(const SSA_stept &step) const;
 };
@@ -237,8 +290,10 @@ public:
   smt_convt &conv;
   std::list<smt_convt::ast_vec> assert_vec_list;
   std::list<smt_astt> assumpt_chain;
-  std::list<SSA_stepst::iterator> scoped_end_points;
-  SSA_stepst::iterator cvt_progress;
+  // Number of steps converted so far, for each pushed context and currently.
+  // Indices, because iterators into SSA_steps do not survive it growing.
+  std::list<size_t> scoped_end_points;
+  size_t cvt_progress;
 };
 
 extern inline bool operator<(
@@ -25,6 +25,7 @@
 #include <boost/mpl/vector.hpp>
 #include <boost/preprocessor/list/adt.hpp>
 #include <boost/preprocessor/list/for_each.hpp>
+#include <atomic>
 #include <cstdarg>
 #include <functional>
 #include <mutex>
@@ -262,7 +263,7 @@ public:
   {
     detach();
     T *tmp = std::shared_ptr<T>::get();
-    tmp->crc_val = 0;
+    tmp->crc_val.store(0, std::memory_order_relaxed);
     return tmp;
   }
 
@@ -317,14 +318,8 @@ public:
 
   size_t crc() const
   {
-    const T *foo = get();
-    {
-      std::lock_guard<std::mutex> lock(foo->crc_mutex);
-      if (foo->crc_val != 0)
-        return foo->crc_val;
-    }
-
-    return foo->do_crc();
+    // do_crc() returns the cached value when there is one
+    return get()->do_crc();
   }
 
   /* Provide comparison operators here as inline friends so they don't pollute
@@ -608,8 +603,10 @@ public:
   // XXX XXX XXX this should be const
   type_ids type_id;
 
-  mutable size_t crc_val;
-  mutable std::mutex crc_mutex;
+  /** Cached hash of this irep, 0 if not computed yet. It only ever holds 0
+   *  or the final value, so it's published without a lock; threads racing on
+   *  an empty cache compute the same value. */
+  mutable std::atomic<size_t> crc_val;
 };
 
 /** Fetch identifying name for a type.
@@ -864,8 +861,10 @@ public:
   /** Type of this expr. All exprs have a type. */
   type2tc type;
 
-  mutable size_t crc_val;
-  mutable std::mutex crc_mutex;
+  /** Cached hash of this irep, 0 if not computed yet. It only ever holds 0
+   *  or the final value, so it's published without a lock; threads racing on
+   *  an empty cache compute the same value. */
+  mutable std::atomic<size_t> crc_val;
 };
 
 inline bool is_nil_expr(const expr2tc &exp)
@@ -1177,7 +1176,7 @@ protected:
     unsigned int indent) const;
   bool cmp_rec(const base2t &ref) const;
   int lt_rec(const base2t &ref) const;
-  void do_crc_rec() const;
+  void do_crc_rec(size_t &crc) const;
   void hash_rec(crypto_hash &hash) const;
 
   // These methods are specific to expressions rather than types, and are
@@ -1246,8 +1245,9 @@ protected:
     return 0;
   }
 
-  void do_crc_rec() const
+  void do_crc_rec(size_t &crc) const
   {
+    (void)crc;
   }
 
   void hash_rec(crypto_hash &hash) const
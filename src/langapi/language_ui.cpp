@@ -32,6 +32,11 @@ language_uit &language_uit::operator=(language_uit &&o) noexcept
 
 bool language_uit::parse(const cmdlinet &cmdline)
 {
+  if (
+    config.options.get_bool_option("parallel-frontend") &&
+    cmdline.args.size() > 1)
+    return parse_together(cmdline.args);
+
   for (const auto &arg : cmdline.args)
   {
     if (parse(arg))
@@ -42,12 +47,56 @@ bool language_uit::parse(const cmdlinet &cmdline)
 }
 
 bool language_uit::parse(const std::string &filename)
+{
+  languaget *language = language_for(filename);
+  if (!language)
+    return true;
+
+  if (language->parse(filename))
+  {
+    log_error("PARSING ERROR");
+    return true;
+  }
+
+  return false;
+}
+
+bool language_uit::parse_together(const std::vector<std::string> &filenames)
+{
+  languaget *language = nullptr;
+  for (const std::string &filename : filenames)
+  {
+    languaget *l = language_for(filename);
+    if (!l)
+      return true;
+
+    if (language && l != language)
+    {
+      // Mixed languages are parsed one file at a time
+      for (const std::string &f : filenames)
+        if (parse(f))
+          return true;
+      return false;
+    }
+    language = l;
+  }
+
+  if (language->parse_files(filenames))
+  {
+    log_error("PARSING ERROR");
+    return true;
+  }
+
+  return false;
+}
+
+languaget *language_uit::language_for(const std::string &filename)
 {
   language_idt lang = language_id_by_path(filename);
   if (lang == language_idt::NONE)
   {
     log_error("failed to figure out type of file {}", filename);
-    return true;
+    return nullptr;
   }
 
   config.language.lid = lang;
@@ -57,7 +106,7 @@ bool language_uit::parse(const std::string &filename)
   if (!infile)
   {
     log_error("failed to open input file {}", filename);
-    return true;
+    return nullptr;
   }
 
   log_progress("Parsing {}", filename);
@@ -76,16 +125,10 @@ bool language_uit::parse(const std::string &filename)
       "{}frontend for {} was not built on this version of ESBMC",
       config.options.get_bool_option("old-frontend") ? "old-" : "",
       language_name(lang));
-    return true;
+    return nullptr;
   }
 
-  if (it->second->parse(filename))
-  {
-    log_error("PARSING ERROR");
-    return true;
-  }
-
-  return false;
+  return it->second.get();
 }
 
 bool language_uit::typecheck()
@@ -18,6 +18,8 @@ public:
 
   virtual bool parse(const cmdlinet &cmdline);
   virtual bool parse(const std::string &filename);
+  // Parses all files at once if they have the same language
+  bool parse_together(const std::vector<std::string> &filenames);
   virtual bool typecheck();
   virtual bool final();
 
@@ -31,6 +33,9 @@ public:
   virtual void show_symbol_table_xml_ui();
 
 protected:
+  /// The frontend for filename, or nullptr if there is none
+  languaget *language_for(const std::string &filename);
+
   /* The instance of this class manages the global migrate_namespace_lookup,
    * thus it cannot be copied. These functions are protected in order for
    * derived classes to opt-into move support. */
@@ -132,37 +132,42 @@ bool value_sett::make_union(const value_sett::valuest &new_values, bool keepnew)
   bool result = false;
 
   // Iterate over all new values; if they're in the current value set, merge
-  // them. If not, only merge it in if keepnew is true.
-  for (const auto &new_value : new_values)
-  {
-    valuest::iterator it2 = values.find(new_value.first);
+  // them. If not, only merge it in if keepnew is true. Entries still shared
+  // with our own values are identical and are skipped; the walk is over a
+  // copy of them as they are modified on the way.
+  const valuest old_values = values;
+  new_values.for_each_difference(
+    old_values, [this, &result, keepnew](const auto &new_value, auto *old_e) {
+      // If the new variable isn't in this set
+      if (old_e == nullptr)
+      {
+        // We always track these when merging value sets, as these store data
+        // that's transferred back and forth between function calls. So, the
+        // variables not existing in the state we're merging into is
+        // irrelevant.
+        if (
+          has_prefix(
+            id2string(new_value.second.identifier),
+            "value_set::dynamic_object") ||
+          new_value.second.identifier == "value_set::return_value" || keepnew)
+        {
+          values.insert(new_value);
+          result = true;
+        }
 
-    // If the new variable isn't in this set
-    if (it2 == values.end())
-    {
-      // We always track these when merging value sets, as these store data
-      // that's transferred back and forth between function calls. So, the
-      // variables not existing in the state we're merging into is irrelevant.
-      if (
-        has_prefix(
-          id2string(new_value.second.identifier),
-          "value_set::dynamic_object") ||
-        new_value.second.identifier == "value_set::return_value" || keepnew)
+        return;
+      }
+
+      // The variable was in this set, merge the values. Check on the shared
+      // entry first, so that nothing is copied if that doesn't change it.
+      const entryt &new_e = new_value.second;
+      object_mapt merged = old_e->object_map;
+      if (make_union(merged, new_e.object_map))
       {
-        values.insert(new_value);
+        values[new_value.first].object_map = std::move(merged);
         result = true;
       }
-
-      continue;
-    }
-
-    // The variable was in this set, merge the values.
-    entryt &e = it2->second;
-    const entryt &new_e = new_value.second;
-
-    if (make_union(e.object_map, new_e.object_map))
-      result = true;
-  }
+    });
 
   return result;
 }
@@ -1195,7 +1200,8 @@ void value_sett::do_free(const expr2tc &op)
 
   // mark these as 'may be invalid'
   // this, unfortunately, destroys the sharing
-  for (auto &value : values)
+  const valuest old_values = values;
+  for (const auto &value : old_values)
   {
     object_mapt new_object_map;
 
@@ -1229,7 +1235,7 @@ void value_sett::do_free(const expr2tc &op)
     }
 
     if (changed)
-      value.second.object_map = new_object_map;
+      values[value.first].object_map = new_object_map;
   }
 }
 
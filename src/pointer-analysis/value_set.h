@@ -7,6 +7,7 @@
 #include <util/mp_arith.h>
 #include <util/namespace.h>
 #include <util/numbering.h>
+#include <util/persistent_map.h>
 #include <util/type_byte_size.h>
 
 /** Code for tracking "value sets" across assignments in ESBMC.
@@ -245,8 +246,8 @@ public:
 
   /** Type of the value-set containing structure. A hash map mapping variables
    *  to an entryt, storing the value set of objects a variable might point
-   *  at. */
-  typedef std::unordered_map<irep_idt, entryt, irep_id_hash> valuest;
+   *  at. Copies of a value set share the entries neither of them changed. */
+  typedef persistent_mapt<irep_idt, entryt, irep_id_hash> valuest;
 
   /** Get the natural alignment unit of a reference to e. I don't know a more
    *  appropriate term, but if we were to have an offset into e, then what is
@@ -474,10 +475,7 @@ public:
   {
     std::string index = id2string(e.identifier) + e.suffix;
 
-    std::pair<valuest::iterator, bool> r =
-      values.insert(std::pair<irep_idt, entryt>(index, e));
-
-    return r.first->second;
+    return *values.insert(std::pair<irep_idt, entryt>(index, e)).first;
   }
 
   /** Add a value set for each variable in the given list. */
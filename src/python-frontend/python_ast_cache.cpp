@@ -0,0 +1,220 @@
+#include <python-frontend/python_ast_cache.h>
+#include <util/crypto_hash.h>
+#include <util/message.h>
+
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#include <boost/filesystem.hpp>
+#include <nlohmann/json.hpp>
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+// Stands for the AST output directory in the cached files; the directory is
+// a new temporary one in every run
+const std::string dir_placeholder = "@ESBMC_AST_OUTPUT_DIR@";
+// Lists "<hash> <path>" of the imported modules the entry depends on
+const std::string imports_file = "imports";
+
+bool read_file(const fs::path &path, std::string &contents)
+{
+  std::ifstream in(path.string(), std::ios::binary);
+  if (!in)
+    return false;
+  std::ostringstream buf;
+  buf << in.rdbuf();
+  contents = buf.str();
+  return true;
+}
+
+bool write_file(const fs::path &path, const std::string &contents)
+{
+  std::ofstream out(path.string(), std::ios::binary);
+  out << contents;
+  return bool(out);
+}
+
+std::string hash_string(const std::string &s)
+{
+  crypto_hash hash;
+  hash.ingest(s.data(), s.size());
+  hash.fin();
+  return hash.to_string();
+}
+
+/// How s is written inside a JSON string
+std::string json_escaped(const std::string &s)
+{
+  const std::string quoted = nlohmann::json(s).dump();
+  return quoted.substr(1, quoted.size() - 2);
+}
+
+void replace_all(std::string &s, const std::string &from, const std::string &to)
+{
+  for (size_t pos = s.find(from); pos != std::string::npos;
+       pos = s.find(from, pos + to.size()))
+    s.replace(pos, from.size(), to);
+}
+} // namespace
+
+python_ast_cachet::python_ast_cachet(
+  const std::string &dir,
+  const std::string &script,
+  const std::string &parser_version,
+  const std::string &python_exec)
+  : dir(dir), script(script)
+{
+  std::string contents;
+  if (!read_file(script, contents))
+    return;
+
+  // The directory of the script decides where imports are searched, and the
+  // path as given is recorded in the AST. The same relative path names
+  // different scripts when run from different directories
+  boost::system::error_code ec;
+  const fs::path script_path = fs::canonical(script, ec);
+  if (ec)
+    return;
+
+  // A new interpreter may produce a different AST
+  const std::time_t python_time = fs::last_write_time(python_exec, ec);
+
+  const std::string salt = parser_version + "\n" + python_exec + "\n" +
+                           std::to_string(python_time) + "\n" +
+                           script_path.string() + "\n" + script + "\n";
+  key = hash_string(salt + contents);
+}
+
+std::string python_ast_cachet::entry_path() const
+{
+  // Fan out like git objects to keep the directories small
+  return (fs::path(dir) / key.substr(0, 2) / key.substr(2)).string();
+}
+
+bool python_ast_cachet::load(const std::string &ast_output_dir) const
+{
+  if (key.empty())
+    return false;
+
+  const fs::path entry(entry_path());
+  std::string imports;
+  if (!read_file(entry / imports_file, imports))
+    return false;
+
+  std::istringstream lines(imports);
+  std::string line;
+  while (std::getline(lines, line))
+  {
+    size_t space = line.find(' ');
+    std::string contents;
+    if (
+      space == std::string::npos ||
+      !read_file(line.substr(space + 1), contents) ||
+      hash_string(contents) != line.substr(0, space))
+    {
+      log_debug("python", "Cached AST of {} is out of date", script);
+      return false;
+    }
+  }
+
+  const std::string new_dir = json_escaped(ast_output_dir);
+  boost::system::error_code ec;
+  for (fs::recursive_directory_iterator it(entry, ec), end; it != end;
+       it.increment(ec))
+  {
+    if (ec)
+      return false;
+    if (!fs::is_regular_file(it->path()) || it->path().extension() != ".json")
+      continue;
+
+    std::string json;
+    if (!read_file(it->path(), json))
+      return false;
+    replace_all(json, dir_placeholder, new_dir);
+
+    const fs::path target =
+      fs::path(ast_output_dir) / fs::relative(it->path(), entry, ec);
+    fs::create_directories(target.parent_path(), ec);
+    if (!write_file(target, json))
+      return false;
+  }
+
+  return !ec;
+}
+
+void python_ast_cachet::store(const std::string &ast_output_dir) const
+{
+  if (key.empty())
+    return;
+
+  const fs::path entry(entry_path());
+  const fs::path out_dir(ast_output_dir);
+  const std::string out_dir_name = out_dir.filename().string();
+  const std::string old_dir = json_escaped(ast_output_dir);
+
+  // Write to a temporary directory first, so that concurrent runs sharing
+  // the cache never read a partial entry
+  fs::path tmp = entry;
+  tmp += "." + std::to_string(std::random_device()()) + ".tmp";
+
+  boost::system::error_code ec;
+  std::string imports;
+  bool ok = true;
+  for (fs::recursive_directory_iterator it(out_dir, ec), end;
+       ok && !ec && it != end;
+       it.increment(ec))
+  {
+    if (!fs::is_regular_file(it->path()) || it->path().extension() != ".json")
+      continue;
+
+    std::string json;
+    if (!read_file(it->path(), json))
+    {
+      ok = false;
+      break;
+    }
+
+    // Modules imported from outside of the output directory (the models are
+    // in there) must not change for the entry to stay valid
+    std::string filename;
+    try
+    {
+      filename = nlohmann::json::parse(json).value("filename", "");
+    }
+    catch (const nlohmann::json::exception &)
+    {
+    }
+    std::string contents;
+    if (
+      !filename.empty() && filename != script &&
+      filename.find(out_dir_name) == std::string::npos &&
+      read_file(filename, contents))
+      imports += hash_string(contents) + " " + filename + "\n";
+
+    replace_all(json, old_dir, dir_placeholder);
+    const fs::path target = tmp / fs::relative(it->path(), out_dir, ec);
+    fs::create_directories(target.parent_path(), ec);
+    ok = write_file(target, json);
+  }
+
+  if (ok && !ec)
+  {
+    fs::create_directories(tmp, ec);
+    ok = write_file(tmp / imports_file, imports);
+  }
+
+  if (!ok || ec)
+  {
+    log_warning("Could not write to the Python AST cache {}", dir);
+    fs::remove_all(tmp, ec);
+    return;
+  }
+
+  // Somebody else may have stored the same entry in the meantime
+  fs::rename(tmp, entry, ec);
+  if (ec)
+    fs::remove_all(tmp, ec);
+}
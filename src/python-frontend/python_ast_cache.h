@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+
+/**
+ * @brief On-disk cache of the JSON ASTs generated by parser.py.
+ *
+ * Running parser.py means starting a Python interpreter and writing, then
+ * reading back, one JSON file per module, including the bundled models. For
+ * many small scripts this dominates the time spent in the frontend.
+ *
+ * An entry is identified by the contents of the script, the embedded parser
+ * and models and the Python interpreter used. It holds every JSON file of the
+ * AST output directory, with that directory's path replaced by a placeholder,
+ * and the hashes of the other modules the script imported. An entry is only
+ * used while those modules are unchanged.
+ */
+class python_ast_cachet
+{
+public:
+  /**
+   * @param dir directory holding the entries, shared between runs
+   * @param script the Python script being parsed
+   * @param parser_version hash of the embedded parser.py and models
+   * @param python_exec path of the Python interpreter running parser.py
+   */
+  python_ast_cachet(
+    const std::string &dir,
+    const std::string &script,
+    const std::string &parser_version,
+    const std::string &python_exec);
+
+  /// Fills ast_output_dir from the entry for the script; false if there is
+  /// no valid entry
+  bool load(const std::string &ast_output_dir) const;
+
+  /// Records the JSON files parser.py wrote to ast_output_dir
+  void store(const std::string &ast_output_dir) const;
+
+protected:
+  std::string dir;
+  std::string script;
+  /// Empty if the script can't be read, which disables the cache
+  std::string key;
+
+  std::string entry_path() const;
+};
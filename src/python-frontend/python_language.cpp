@@ -1,11 +1,13 @@
 #include <python-frontend/python_language.h>
 #include <python-frontend/python_converter.h>
 #include <python-frontend/python_annotation.h>
+#include <python-frontend/python_ast_cache.h>
 #include <python-frontend/global_scope.h>
 #include <clang-cpp-frontend/clang_cpp_adjust.h>
 #include <util/message.h>
 #include <util/filesystem.h>
 #include <util/c_expr2string.h>
+#include <util/crypto_hash.h>
 #include <c2goto/cprover_library.h>
 
 #include <cstdlib>
@@ -48,6 +50,17 @@ static const std::string &dump_python_script()
   return p.path();
 }
 
+// Identifies the embedded parser and models for the AST cache
+static std::string parser_version()
+{
+  crypto_hash hash;
+#define ESBMC_FLAIL(body, size, ...) hash.ingest(body, size);
+#include <pythonastgen.h>
+#undef ESBMC_FLAIL
+  hash.fin();
+  return hash.to_string();
+}
+
 languaget *new_python_language()
 {
   return new python_languaget;
@@ -88,15 +101,29 @@ bool python_languaget::parse(const std::string &path)
     exit(1);
   }
 
-  // Create a child process to execute Python
-  bp::child process(python_exec_path, args);
+  std::unique_ptr<python_ast_cachet> cache;
+  const std::string cache_dir = config.options.get_option("python-ast-cache");
+  if (!cache_dir.empty())
+    cache = std::make_unique<python_ast_cachet>(
+      cache_dir, path, parser_version(), python_exec_path.string());
 
-  // Wait for execution
-  process.wait();
+  if (cache && cache->load(ast_output_dir))
+    log_debug("python", "Reusing the cached AST of {}", path);
+  else
+  {
+    // Create a child process to execute Python
+    bp::child process(python_exec_path, args);
+
+    // Wait for execution
+    process.wait();
 
-  // parser.py execution failed
-  if (process.exit_code())
-    exit(process.exit_code());
+    // parser.py execution failed
+    if (process.exit_code())
+      exit(process.exit_code());
+
+    if (cache)
+      cache->store(ast_output_dir);
+  }
 
   std::stringstream script_path;
   script_path << ast_output_dir << "/" << script.stem().string() << ".json";
@@ -19,6 +19,10 @@
 const nlohmann::json solidity_convertert::empty_json = nlohmann::json::object();
 std::string solidity_convertert::current_baseContractName = "";
 nlohmann::json solidity_convertert::src_ast_json = empty_json;
+std::map<
+  std::tuple<const nlohmann::json *, bool, std::string>,
+  solidity_convertert::decl_ref_indext>
+  solidity_convertert::decl_ref_indexes;
 std::unordered_map<std::string, typet> solidity_convertert::UserDefinedVarMap;
 
 solidity_convertert::solidity_convertert(
@@ -120,6 +124,7 @@ bool solidity_convertert::convert()
 {
   // merge the input files
   merge_multi_files();
+  clear_decl_ref_index();
 
   // By now the context should have the symbols of all ESBMC's intrinsics and the dummy main
   // We need to convert Solidity AST nodes to thstructe equivalent symbols and add them to the context
@@ -2140,7 +2145,7 @@ bool solidity_convertert::get_noncontract_defition(nlohmann::json &ast_node)
 // the idea is to utilize the function-handling APIs.
 void solidity_convertert::add_empty_body_node(nlohmann::json &ast_node)
 {
-  //? will this affect find_decl_ref?
+  // the new nodes have no id, so find_decl_ref is not affected
   if (ast_node["nodeType"] == "EventDefinition")
   {
     // for event-definition
@@ -2462,6 +2467,7 @@ void solidity_convertert::merge_inheritance_ast(
         add_inherit_label(i, c_name);
 
         c_node["nodes"].push_back(i);
+        clear_decl_ref_index();
       }
     }
   }
@@ -3408,6 +3414,7 @@ bool solidity_convertert::delete_modifier_json(
           (*it)["name"] == fname)
         {
           contract_nodes.erase(it);
+          clear_decl_ref_index();
           modifier_def = nullptr;
           return false;
         }
@@ -3468,6 +3475,7 @@ bool solidity_convertert::insert_modifier_json(
         {"src", src}};
 
       contract_nodes.push_back(new_function);
+      clear_decl_ref_index();
       modifier_def = &contract_nodes.back();
       return false;
     }
@@ -10224,11 +10232,104 @@ const nlohmann::json &solidity_convertert::find_parent_contract(
   return empty_json;
 }
 
+void solidity_convertert::clear_decl_ref_index()
+{
+  decl_ref_indexes.clear();
+}
+
+const solidity_convertert::decl_ref_indext *
+solidity_convertert::get_decl_ref_index(const nlohmann::json &j, bool global)
+{
+  // Only the AST itself lives long enough for its address to identify it
+  auto nodes = src_ast_json.find("nodes");
+  if (&j != &src_ast_json && (nodes == src_ast_json.end() || &j != &*nodes))
+    return nullptr;
+
+  auto key = std::make_tuple(
+    &j, global, global ? current_baseContractName : std::string());
+  auto it = decl_ref_indexes.find(key);
+  if (it == decl_ref_indexes.end())
+  {
+    it = decl_ref_indexes.emplace(key, decl_ref_indext()).first;
+    if (global)
+      index_decl_refs_global(j, it->second);
+    else
+      index_decl_refs_in_contract(j, it->second);
+  }
+  return &it->second;
+}
+
+// Records the first node with each id, in the order find_decl_ref_in_contract
+// visits them
+void solidity_convertert::index_decl_refs_in_contract(
+  const nlohmann::json &j,
+  decl_ref_indext &index)
+{
+  if (j.is_object())
+  {
+    auto id = j.find("id");
+    if (id != j.end() && id->is_number_integer())
+      index.emplace(id->get<int>(), &j);
+  }
+
+  for (const auto &child : j)
+    if (child.is_structured())
+      index_decl_refs_in_contract(child, index);
+}
+
+// Records the first node with each id, in the order find_decl_ref_global
+// visits them
+void solidity_convertert::index_decl_refs_global(
+  const nlohmann::json &j,
+  decl_ref_indext &index)
+{
+  if (j.is_object())
+  {
+    auto id = j.find("id");
+    if (id != j.end() && id->is_number_integer())
+      index.emplace(id->get<int>(), &j);
+
+    if (j.contains("nodeType") && j["nodeType"] == "ContractDefinition")
+    {
+      // only libraries and the base contract are searched
+      const bool is_library =
+        j.contains("contractKind") && j["contractKind"] == "library";
+      const bool is_base = j.contains("name") &&
+                           !current_baseContractName.empty() &&
+                           j["name"] == current_baseContractName;
+      if (is_library || is_base)
+        index_decl_refs_in_contract(j, index);
+      return;
+    }
+  }
+
+  for (const auto &child : j)
+    if (child.is_structured())
+      index_decl_refs_global(child, index);
+}
+
 // Searches for the target node inside a contract body.
 // Assumes that the caller is already in the base contract node.
 const nlohmann::json &solidity_convertert::find_decl_ref_in_contract(
   const nlohmann::json &j,
   int ref_id)
+{
+  const decl_ref_indext *index = get_decl_ref_index(j, false);
+  if (!index)
+    return walk_decl_ref_in_contract(j, ref_id);
+
+  auto it = index->find(ref_id);
+  const nlohmann::json &result = it == index->end() ? empty_json : *it->second;
+  // the index must find what the walk it replaces finds
+  assert(&result == &walk_decl_ref_in_contract(j, ref_id));
+  if (it != index->end())
+    log_debug("solidity", "\tfound");
+  return result;
+}
+
+const nlohmann::json &solidity_convertert::walk_decl_ref_in_contract(
+  const nlohmann::json &j,
+  int ref_id)
 {
   // Check if this node matches the ref_id.
   // Skip any nested contract definition (should not occur).
@@ -10277,6 +10378,20 @@ const nlohmann::json &solidity_convertert::find_decl_ref_in_contract(
 // is considered and, if matched, its body is searched using find_decl_ref_in_contract.
 const nlohmann::json &
 solidity_convertert::find_decl_ref_global(const nlohmann::json &j, int ref_id)
+{
+  const decl_ref_indext *index = get_decl_ref_index(j, true);
+  if (!index)
+    return walk_decl_ref_global(j, ref_id);
+
+  auto it = index->find(ref_id);
+  const nlohmann::json &result = it == index->end() ? empty_json : *it->second;
+  // the index must find what the walk it replaces finds
+  assert(&result == &walk_decl_ref_global(j, ref_id));
+  return result;
+}
+
+const nlohmann::json &
+solidity_convertert::walk_decl_ref_global(const nlohmann::json &j, int ref_id)
 {
   if (!j.is_structured())
     return empty_json;
@@ -11528,6 +11643,7 @@ void solidity_convertert::get_inherit_ctor_definition(
       if (node["nodeType"] == "ContractDefinition" && node["name"] == c_name)
         node["nodes"].push_back(ctor_json);
     }
+    clear_decl_ref_index();
 
     if (
       (*current_functionDecl).contains("body") ||
@@ -11562,6 +11678,7 @@ void solidity_convertert::get_inherit_ctor_definition(
         }
       }
     }
+    clear_decl_ref_index();
   }
 
   // reset
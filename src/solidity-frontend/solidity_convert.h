@@ -6,6 +6,8 @@
 #include <vector>
 #include <map>
 #include <queue>
+#include <tuple>
+#include <unordered_map>
 #include <util/context.h>
 #include <util/namespace.h>
 #include <util/std_types.h>
@@ -45,6 +47,8 @@ public:
   find_decl_ref_unique_id(const nlohmann::json &json, int ref_id);
   static const nlohmann::json &
   find_decl_ref(const nlohmann::json &json, int ref_id);
+  // must be called whenever nodes are added to or removed from src_ast_json
+  static void clear_decl_ref_index();
   static const nlohmann::json &find_constructor_ref(int ref_decl_id);
   static const nlohmann::json &
   find_constructor_ref(const std::string &contract_name);
@@ -65,6 +69,27 @@ public:
   static std::unordered_map<std::string, typet> UserDefinedVarMap;
 
 protected:
+  // Declarations by id, built by the first lookup from src_ast_json or its
+  // "nodes", so that the following ones don't have to walk the AST again.
+  // Indexed by root node, whether the lookup is global and, for global
+  // lookups, the base contract name.
+  typedef std::unordered_map<int, const nlohmann::json *> decl_ref_indext;
+  static std::map<
+    std::tuple<const nlohmann::json *, bool, std::string>,
+    decl_ref_indext>
+    decl_ref_indexes;
+  static const decl_ref_indext *
+  get_decl_ref_index(const nlohmann::json &j, bool global);
+  static void
+  index_decl_refs_in_contract(const nlohmann::json &j, decl_ref_indext &index);
+  static void
+  index_decl_refs_global(const nlohmann::json &j, decl_ref_indext &index);
+  // The searches the indexes replace, checked against them in debug builds
+  static const nlohmann::json &
+  walk_decl_ref_in_contract(const nlohmann::json &j, int ref_id);
+  static const nlohmann::json &
+  walk_decl_ref_global(const nlohmann::json &j, int ref_id);
+
   typedef struct func_sig
   {
     std::string name;
@@ -0,0 +1,189 @@
+#include <solvers/dimacs/dimacs_solver.h>
+#include <util/filesystem.h>
+#include <util/message.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#ifndef _WIN32
+#  include <signal.h>
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
+dimacs_solvert::dimacs_solvert(const std::string &cmd) : cmd(cmd)
+{
+}
+
+const char *dimacs_solvert::signature() const
+{
+  return "DIMACS";
+}
+
+void dimacs_solvert::add(int lit)
+{
+  clauses.push_back(lit);
+  if (lit == 0)
+    num_clauses++;
+  else
+    num_vars = std::max(num_vars, std::abs(lit));
+}
+
+void dimacs_solvert::assume(int lit)
+{
+  assumptions.push_back(lit);
+  num_vars = std::max(num_vars, std::abs(lit));
+}
+
+void dimacs_solvert::write(FILE *out) const
+{
+  fprintf(out, "p cnf %d %zu\n", num_vars, num_clauses + assumptions.size());
+  for (int lit : clauses)
+    fprintf(out, lit == 0 ? "0\n" : "%d ", lit);
+  for (int lit : assumptions)
+    fprintf(out, "%d 0\n", lit);
+}
+
+int dimacs_solvert::val(int lit) const
+{
+  size_t var = std::abs(lit);
+  if (var >= model.size() || model[var] == 0)
+    return 0;
+  return (lit > 0) == (model[var] > 0) ? lit : -lit;
+}
+
+void dimacs_solvert::terminate()
+{
+  std::lock_guard lock(process_mutex);
+  terminated = true;
+#ifndef _WIN32
+  if (pid > 0)
+    kill(pid, SIGTERM);
+#endif
+}
+
+int dimacs_solvert::read_answer(FILE *in)
+{
+  int answer = 0;
+  char *line = nullptr;
+  size_t size = 0;
+  while (getline(&line, &size, in) != -1)
+  {
+    if (!strncmp(line, "s SATISFIABLE", 13))
+      answer = 10;
+    else if (!strncmp(line, "s UNSATISFIABLE", 15))
+      answer = 20;
+    else if (line[0] == 'v')
+    {
+      char *pos = line + 1;
+      char *end;
+      for (long lit = strtol(pos, &end, 10); end != pos && lit != 0;
+           lit = strtol(pos, &end, 10))
+      {
+        size_t var = std::labs(lit);
+        if (var >= model.size())
+          model.resize(var + 1, 0);
+        model[var] = lit > 0 ? 1 : -1;
+        pos = end;
+      }
+    }
+  }
+  free(line);
+  return answer;
+}
+
+int dimacs_solvert::solve()
+{
+  model.clear();
+
+#ifdef _WIN32
+  log_error("DIMACS solvers work only in unix systems");
+  abort();
+#else
+  file_operations::tmp_file input =
+    file_operations::create_tmp_file("esbmc-dimacs.%%%%-%%%%-%%%%.cnf");
+  write(input.file());
+  assumptions.clear();
+  if (fflush(input.file()) != 0)
+  {
+    log_error("Couldn't write {}: {}", input.path(), strerror(errno));
+    return 0;
+  }
+
+  int outpipe[2];
+  if (pipe(outpipe) != 0)
+  {
+    log_error("Couldn't open a pipe for the DIMACS solver");
+    abort();
+  }
+
+  const std::string command = cmd + " '" + input.path() + "'";
+  int answer = 0;
+  int status = 0;
+  {
+    std::lock_guard lock(process_mutex);
+    if (terminated)
+    {
+      terminated = false;
+      close(outpipe[0]);
+      close(outpipe[1]);
+      return 0;
+    }
+
+    pid = fork();
+    if (pid == 0)
+    {
+      close(outpipe[0]);
+      dup2(outpipe[1], STDOUT_FILENO);
+      close(outpipe[1]);
+
+      const char *shell = getenv("SHELL");
+      if (!shell || !*shell)
+        shell = "sh";
+
+      execlp(shell, shell, "-c", command.c_str(), NULL);
+      log_error(
+        "Exec of DIMACS solver failed: {} -c {}: {}",
+        shell,
+        command,
+        strerror(errno));
+      _exit(1);
+    }
+  }
+
+  close(outpipe[1]);
+  if (pid < 0)
+  {
+    log_error("Couldn't start the DIMACS solver: {}", strerror(errno));
+    close(outpipe[0]);
+    abort();
+  }
+
+  FILE *out = fdopen(outpipe[0], "r");
+  answer = read_answer(out);
+  fclose(out);
+  waitpid(pid, &status, 0);
+
+  std::lock_guard lock(process_mutex);
+  pid = 0;
+  if (terminated)
+  {
+    terminated = false;
+    return 0;
+  }
+
+  // Solvers that print no status line still report it in their exit code
+  if (answer == 0 && WIFEXITED(status))
+  {
+    int code = WEXITSTATUS(status);
+    if (code == 10 || code == 20)
+      answer = code;
+  }
+
+  if (answer == 0)
+    log_error("DIMACS solver `{}' gave no answer", cmd);
+  return answer;
+#endif
+}
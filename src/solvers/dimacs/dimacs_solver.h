@@ -0,0 +1,58 @@
+#ifndef _ESBMC_SOLVERS_DIMACS_DIMACS_SOLVER_H_
+#define _ESBMC_SOLVERS_DIMACS_DIMACS_SOLVER_H_
+
+#include <cstdio>
+#include <mutex>
+#include <solvers/sat/ipasir_iface.h>
+#include <string>
+#include <vector>
+
+/**
+ * @brief IPASIR solver running an external SAT solver binary.
+ *
+ * The clauses are kept here. Every solve() writes them, and the assumptions
+ * as unit clauses, to a temporary DIMACS file and runs the command on it,
+ * e.g. "kissat -q" or "cadical -q". The answer is read back from the
+ * solver's output in the format of the SAT competition: an "s SATISFIABLE"
+ * or "s UNSATISFIABLE" line, and "v" lines listing the model. As the
+ * clauses are kept, solve() may be called again after adding more.
+ */
+class dimacs_solvert : public ipasir_iface
+{
+public:
+  /// @param cmd the solver's command line, run by the shell with the path
+  ///        of the DIMACS file appended
+  explicit dimacs_solvert(const std::string &cmd);
+
+  const char *signature() const override;
+  void add(int lit) override;
+  void assume(int lit) override;
+  int solve() override;
+  int val(int lit) const override;
+  void terminate() override;
+
+  /// Writes the clauses added so far and the current assumptions in DIMACS
+  void write(FILE *out) const;
+
+protected:
+  std::string cmd;
+
+  /// Literals of every clause, each clause ended by a 0
+  std::vector<int> clauses;
+  size_t num_clauses = 0;
+  int num_vars = 0;
+  std::vector<int> assumptions;
+
+  /// Value of every variable in the last model: 1, -1 or 0 if unknown
+  std::vector<signed char> model;
+
+  /// The running solver process, for terminate()
+  std::mutex process_mutex;
+  int pid = 0;
+  bool terminated = false;
+
+  /// Reads the answer from the solver's output; 0 if it doesn't give one
+  int read_answer(FILE *in);
+};
+
+#endif /* _ESBMC_SOLVERS_DIMACS_DIMACS_SOLVER_H_ */
@@ -0,0 +1,80 @@
+#include <solvers/dimacs/ipasir_cnf.h>
+
+ipasir_cnft::ipasir_cnft(ipasir_iface &_sat_solver)
+  : cnf_iface(),
+    cnf_convt(static_cast<cnf_iface *>(this)),
+    sat_solver(_sat_solver)
+{
+}
+
+int ipasir_cnft::dimacs_literal(literalt l)
+{
+  // DIMACS variables start at 1
+  int var = l.var_no() + 1;
+  return l.sign() ? -var : var;
+}
+
+literalt ipasir_cnft::new_variable()
+{
+  literalt l;
+  l.set(num_vars++, false);
+  return l;
+}
+
+void ipasir_cnft::setto(literalt a, bool val)
+{
+  assert_lit(val ? a : cnf_convt::lnot(a));
+}
+
+void ipasir_cnft::lcnf(const bvt &bv)
+{
+  bvt clause;
+  for (literalt l : bv)
+  {
+    // A clause with a true literal is satisfied, false literals are dropped
+    if (l.is_true())
+      return;
+    if (!l.is_false())
+      clause.push_back(l);
+  }
+
+  if (clause.empty())
+  {
+    false_asserted = true;
+    return;
+  }
+
+  for (literalt l : clause)
+    sat_solver.add(dimacs_literal(l));
+  sat_solver.add(0);
+}
+
+void ipasir_cnft::assert_lit(const literalt &l)
+{
+  lcnf({l});
+}
+
+int ipasir_cnft::solve()
+{
+  // Then the formula can never be satisfied
+  if (false_asserted)
+    return 20;
+
+  return sat_solver.solve();
+}
+
+tvt ipasir_cnft::l_get(const literalt &l)
+{
+  if (l.is_true())
+    return tvt(tvt::TV_TRUE);
+  if (l.is_false())
+    return tvt(tvt::TV_FALSE);
+
+  int lit = dimacs_literal(l);
+  int v = sat_solver.val(lit);
+  if (v == lit)
+    return tvt(tvt::TV_TRUE);
+  if (v == -lit)
+    return tvt(tvt::TV_FALSE);
+  return tvt(tvt::TV_UNKNOWN);
+}
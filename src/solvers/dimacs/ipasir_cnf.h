@@ -0,0 +1,38 @@
+#ifndef _ESBMC_SOLVERS_DIMACS_IPASIR_CNF_H_
+#define _ESBMC_SOLVERS_DIMACS_IPASIR_CNF_H_
+
+#include <solvers/sat/cnf_conv.h>
+#include <solvers/sat/ipasir_iface.h>
+
+/**
+ * @brief Encodes gates into clauses with cnf_convt and hands them to any
+ * IPASIR solver, e.g. a dimacs_solvert.
+ *
+ * This is the SAT half of a CNF backend, the part a bitblaster drives
+ * through sat_iface. literalt variable n is the DIMACS variable n + 1.
+ */
+class ipasir_cnft : public cnf_iface, public cnf_convt
+{
+public:
+  explicit ipasir_cnft(ipasir_iface &sat_solver);
+
+  void setto(literalt a, bool val) override;
+  void lcnf(const bvt &bv) override;
+  void assert_lit(const literalt &l) override;
+  tvt l_get(const literalt &a) override;
+  literalt new_variable() override;
+
+  /// As ipasir_iface::solve(): 10 if satisfiable, 20 if unsatisfiable and
+  /// 0 if the solver gave no answer
+  int solve();
+
+  static int dimacs_literal(literalt l);
+
+protected:
+  ipasir_iface &sat_solver;
+  unsigned num_vars = 0;
+  /// Set once an empty clause was added
+  bool false_asserted = false;
+};
+
+#endif /* _ESBMC_SOLVERS_DIMACS_IPASIR_CNF_H_ */
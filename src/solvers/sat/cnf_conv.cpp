@@ -1,4 +1,12 @@
-#include <cnf_conv.h>
+#include <solvers/sat/cnf_conv.h>
+#include <algorithm>
+
+static uint64_t gate_key(literalt a, literalt b)
+{
+  if (b < a)
+    std::swap(a, b);
+  return (uint64_t(a.get()) << 32) | b.get();
+}
 
 cnf_convt::cnf_convt(cnf_iface *_cnf_api) : sat_iface(), cnf_api(_cnf_api)
 {
@@ -22,9 +30,17 @@ literalt cnf_convt::lselect(literalt a, literalt b, literalt c)
     return c;
   if (b == c)
     return b;
+  if (b == lnot(c))
+    return lequal(a, b);
+  if (a == b)
+    return lor(a, c);
+  if (a == c)
+    return land(a, b);
+  if (a == lnot(b))
+    return land(b, c);
+  if (a == lnot(c))
+    return lor(b, c);
 
-  bvt bv;
-  bv.reserve(2);
   literalt one = land(a, b);
   literalt two = land(lnot(a), c);
   return lor(one, two);
@@ -50,26 +66,40 @@ literalt cnf_convt::lxor(literalt a, literalt b)
     return lnot(b);
   if (b == const_literal(true))
     return lnot(a);
+  if (a == b)
+    return const_literal(false);
+  if (a == lnot(b))
+    return const_literal(true);
 
-  literalt output = this->new_variable();
-  gate_xor(a, b, output);
-  return output;
+  // /a xor b = /(a xor b)
+  bool invert = a.sign() != b.sign();
+  a = a.cond_negation(a.sign());
+  b = b.cond_negation(b.sign());
+
+  auto [it, inserted] = xor_gates.emplace(gate_key(a, b), literalt());
+  if (inserted)
+  {
+    it->second = this->new_variable();
+    gate_xor(a, b, it->second);
+  }
+  return it->second.cond_negation(invert);
 }
 
 literalt cnf_convt::lor(literalt a, literalt b)
 {
-  if (a == const_literal(false))
-    return b;
-  if (b == const_literal(false))
-    return a;
-  if (a == const_literal(true))
-    return const_literal(true);
-  if (b == const_literal(true))
-    return const_literal(true);
+  // a+b = /(/a * /b)
+  return lnot(land(lnot(a), lnot(b)));
+}
 
-  literalt output = this->new_variable();
-  gate_or(a, b, output);
-  return output;
+bvt cnf_convt::conjuncts(literalt a) const
+{
+  if (!a.sign())
+  {
+    auto it = and_inputs.find(a.var_no());
+    if (it != and_inputs.end())
+      return {it->second.first, it->second.second};
+  }
+  return {a};
 }
 
 literalt cnf_convt::land(literalt a, literalt b)
@@ -84,10 +114,35 @@ literalt cnf_convt::land(literalt a, literalt b)
     return const_literal(false);
   if (a == b)
     return a;
+  if (a == lnot(b))
+    return const_literal(false);
+
+  // Rewrite against the gates below: a*(a*c) = a*c and a*(/a*c) = 0
+  bvt a_in = conjuncts(a);
+  bvt b_in = conjuncts(b);
+  for (literalt x : a_in)
+    for (literalt y : b_in)
+      if (x == lnot(y))
+        return const_literal(false);
 
-  literalt output = this->new_variable();
-  gate_and(a, b, output);
-  return output;
+  auto contains = [](const bvt &big, const bvt &small) {
+    return std::all_of(small.begin(), small.end(), [&big](literalt l) {
+      return std::find(big.begin(), big.end(), l) != big.end();
+    });
+  };
+  if (contains(b_in, a_in))
+    return b;
+  if (contains(a_in, b_in))
+    return a;
+
+  auto [it, inserted] = and_gates.emplace(gate_key(a, b), literalt());
+  if (inserted)
+  {
+    it->second = this->new_variable();
+    gate_and(a, b, it->second);
+    and_inputs.emplace(it->second.var_no(), std::make_pair(a, b));
+  }
+  return it->second;
 }
 
 void cnf_convt::gate_xor(literalt a, literalt b, literalt o)
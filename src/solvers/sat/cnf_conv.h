@@ -1,9 +1,10 @@
 #ifndef _ESBMC_SOLVERS_SMT_CNF_CONV_H_
 #define _ESBMC_SOLVERS_SMT_CNF_CONV_H_
 
-#include <solvers/smt/smt_conv.h>
-#include <bitblast_conv.h>
-#include <cnf_iface.h>
+#include <cstdint>
+#include <solvers/sat/cnf_iface.h>
+#include <solvers/sat/sat_iface.h>
+#include <unordered_map>
 
 class cnf_convt : public sat_iface
 {
@@ -25,6 +26,20 @@ public:
   virtual void set_equal(literalt a, literalt b);
 
   cnf_iface *cnf_api;
+
+protected:
+  /* Structural hashing: a gate is only encoded once for the same inputs, so
+   * the repeated subterms of multipliers, shifters and dividers share their
+   * clauses. Inputs are normalised first: they are ordered, or gates are
+   * and gates with inverted inputs and output, and xor gates take positive
+   * inputs. */
+  std::unordered_map<uint64_t, literalt> and_gates;
+  std::unordered_map<uint64_t, literalt> xor_gates;
+  /// Inputs of the and gates, by output variable
+  std::unordered_map<unsigned, std::pair<literalt, literalt>> and_inputs;
+
+  /// The conjuncts of a: the inputs of its and gate if it has one, or a
+  bvt conjuncts(literalt a) const;
 };
 
 #endif /* _ESBMC_SOLVERS_SMT_CNF_CONV_H_ */
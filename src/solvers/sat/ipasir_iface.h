@@ -0,0 +1,34 @@
+#ifndef _ESBMC_SOLVERS_SAT_IPASIR_IFACE_H_
+#define _ESBMC_SOLVERS_SAT_IPASIR_IFACE_H_
+
+// The incremental SAT solver interface of the SAT competition, IPASIR, as a
+// class. Literals are DIMACS literals: a variable is a positive number and
+// its negation is the negative one. Anything implementing it can sit below
+// a cnf_convt, whether it is linked in or runs as another process.
+
+class ipasir_iface
+{
+public:
+  virtual ~ipasir_iface() = default;
+
+  virtual const char *signature() const = 0;
+
+  /// Adds lit to the clause being built; 0 ends the clause
+  virtual void add(int lit) = 0;
+
+  /// Assumes lit during the next call to solve() only
+  virtual void assume(int lit) = 0;
+
+  /// 10 if satisfiable, 20 if unsatisfiable, 0 if interrupted or unknown
+  virtual int solve() = 0;
+
+  /// After a satisfiable solve(): lit if it is true in the model, -lit if it
+  /// is false, 0 if the model doesn't say
+  virtual int val(int lit) const = 0;
+
+  /// Makes a running solve() return 0 as soon as possible; may be called
+  /// from another thread
+  virtual void terminate() = 0;
+};
+
+#endif /* _ESBMC_SOLVERS_SAT_IPASIR_IFACE_H_ */
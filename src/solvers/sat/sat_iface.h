@@ -5,6 +5,9 @@
 // SAT bitblaster. I anticipate that nothing else actually needs to use this
 // interface, except perhaps sat solvers that have non-cnf inputs.
 
+#include <solvers/prop/literal.h>
+#include <util/threeval.h>
+
 class sat_iface
 {
 public:
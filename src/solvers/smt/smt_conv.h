@@ -232,6 +232,13 @@ public:
    *  @return Result code of the call to the solver. */
   virtual resultt dec_solve() = 0;
 
+  /** Ask a running dec_solve to give up as soon as possible, in which case it
+   *  returns P_ERROR. May be called from another thread. Solvers that cannot
+   *  be interrupted ignore the request and finish their query. */
+  virtual void interrupt()
+  {
+  }
+
   void pre_solve();
 
   /** Get the satisfying assignment using the type.
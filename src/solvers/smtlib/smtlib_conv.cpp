@@ -386,6 +386,7 @@ std::string smtlib_convt::sort_to_string(const smt_sort *s) const
   case SMT_SORT_FIXEDBV:
   case SMT_SORT_BV:
   case SMT_SORT_BVFP:
+  case SMT_SORT_BVFP_RM:
     ss << "(_ BitVec " << sort->get_data_width() << ")";
     return ss.str();
   case SMT_SORT_ARRAY:
@@ -471,15 +472,8 @@ unsigned int smtlib_convt::emit_terminal_ast(
   }
 }
 
-unsigned int smtlib_convt::emit_ast(
-  const smtlib_smt_ast *ast,
-  std::string &output,
-  std::unordered_map<const smtlib_smt_ast *, std::string> &temp_symbols) const
+static bool is_terminal(const smtlib_smt_ast *ast)
 {
-  unsigned int brace_level = 0;
-  assert(ast->args.size() <= 4);
-  std::string args[4];
-
   switch (ast->kind)
   {
   case SMT_FUNC_INT:
@@ -487,77 +481,87 @@ unsigned int smtlib_convt::emit_ast(
   case SMT_FUNC_BVINT:
   case SMT_FUNC_REAL:
   case SMT_FUNC_SYMBOL:
-    return emit_terminal_ast(ast, output);
+    return true;
   default:
-    break;
-    // Continue.
+    return false;
   }
+}
 
-  if (auto it = temp_symbols.find(ast); it != temp_symbols.end())
+std::string smtlib_convt::term_string(const smtlib_smt_ast *ast) const
+{
+  std::string output;
+  if (is_terminal(ast))
   {
-    output = it->second;
-    return 0;
+    emit_terminal_ast(ast, output);
+    return output;
   }
 
-  // Get a temporary sym name
-  size_t tempnum = temp_symbols.size();
-  std::stringstream ss;
-  ss << "?x" << tempnum;
-  std::string tempname = ss.str();
-
-  temp_symbols.emplace(ast, tempname);
-
-  for (unsigned long int i = 0; i < ast->args.size(); i++)
-    brace_level += emit_ast(
-      static_cast<const smtlib_smt_ast *>(ast->args[i]), args[i], temp_symbols);
-
-  // Emit a let, assigning the result of this AST func to the sym.
-  // For some reason let requires a double-braced operand.
-  emit("(let ((%s (", tempname.c_str());
+  if (auto it = term_names.find(ast); it != term_names.end())
+    return it->second;
 
   // This asts function
   assert(static_cast<size_t>(ast->kind) < smt_func_name_table.size());
   if (ast->kind == SMT_FUNC_EXTRACT)
   {
     // Extract is an indexed function
-    emit("(_ extract %d %d)", ast->extract_high, ast->extract_low);
+    output = "((_ extract " + std::to_string(ast->extract_high) + " " +
+             std::to_string(ast->extract_low) + ")";
   }
   else
-  {
-    emit("%s", smt_func_name_table[ast->kind]);
-  }
+    output = std::string("(") + smt_func_name_table[ast->kind];
 
   // Its operands
-  for (unsigned long int i = 0; i < ast->args.size(); i++)
-    emit(" %s", args[i].c_str());
-
-  // End func enclosing brace, then operand to let (two braces).
-  emit("%s", ")))\n");
+  for (smt_astt arg : ast->args)
+    output += " " + term_string(static_cast<const smtlib_smt_ast *>(arg));
 
-  // We end with one additional brace level.
-  output = tempname;
-  return brace_level + 1;
+  return output + ")";
 }
 
-void smtlib_convt::emit_ast(const smtlib_smt_ast *ast) const
+std::string smtlib_convt::define_terms(const smtlib_smt_ast *ast) const
 {
-  // The algorithm: descend through the AST operands, binding values to
-  // temporary symbols, then emit functions on those temporary symbols.
-  // All recursively. The non-trivial bit is tracking how many ending
-  // braces are required.
-  // This is inspired by the output from Z3 that I've seen.
+  /* Every function application gets a name the first time it is seen, and
+   * is written out once, whatever the number of assertions sharing it. The
+   * DAG is walked with an explicit stack: formulas can be deeper than the
+   * native one. The flag tells whether the operands were pushed already. */
+  std::vector<std::pair<const smtlib_smt_ast *, bool>> stack;
+  stack.emplace_back(ast, false);
+  while (!stack.empty())
+  {
+    auto [node, expanded] = stack.back();
+    if (is_terminal(node) || term_names.count(node))
+    {
+      stack.pop_back();
+      continue;
+    }
 
-  std::string output;
-  std::unordered_map<const smtlib_smt_ast *, std::string> temp_symbols;
-  unsigned int brace_level = emit_ast(ast, output, temp_symbols);
+    if (!expanded)
+    {
+      stack.back().second = true;
+      for (smt_astt arg : node->args)
+        stack.emplace_back(static_cast<const smtlib_smt_ast *>(arg), false);
+      continue;
+    }
 
-  /* Emit the final representation of the root, either a (possibly temporary)
-   * symbol, or that of a terminal. */
-  emit("%s", output.c_str());
+    // All operands have a name by now
+    stack.pop_back();
+    std::string name = "?x" + std::to_string(num_term_names++);
+    emit(
+      "(define-fun %s () %s %s)\n",
+      name.c_str(),
+      sort_to_string(node->sort).c_str(),
+      term_string(node).c_str());
+    term_names.emplace(node, std::move(name));
+    named_terms.push_back(node);
+  }
 
-  // Emit a ton of end braces.
-  for (unsigned int i = 0; i < brace_level; i++)
-    emit("%c", ')');
+  return term_string(ast);
+}
+
+void smtlib_convt::emit_ast(const smtlib_smt_ast *ast) const
+{
+  // Doesn't define anything: also used where commands other than the
+  // current one can't be issued, e.g. inside a get-value
+  emit("%s", term_string(ast).c_str());
 }
 
 void smtlib_smt_ast::dump() const
@@ -826,12 +830,8 @@ void smtlib_convt::assert_ast(smt_astt a)
   const smtlib_smt_ast *sa = static_cast<const smtlib_smt_ast *>(a);
 
   // Encode an assertion
-  emit("%s", "(assert\n");
-
-  emit_ast(sa);
-
-  // Final brace for closing the 'assert'.
-  emit("%s", ")\n");
+  std::string term = define_terms(sa);
+  emit("(assert %s)\n", term.c_str());
 }
 
 smt_astt smtlib_convt::mk_smt_int(const BigInt &theint)
@@ -981,6 +981,7 @@ void smtlib_convt::push_ctx()
   smt_convt::push_ctx();
 
   emit("%s", "(push 1)\n");
+  named_terms_sizes.push_back(named_terms.size());
 }
 
 smt_astt smtlib_convt::mk_add(smt_astt a, smt_astt b)
@@ -1487,6 +1488,12 @@ void smtlib_convt::pop_ctx()
   symbol_tablet::nth_index<1>::type &syms_numindex = symbol_table.get<1>();
   syms_numindex.erase(ctx_level);
 
+  // And the terms defined since the push
+  for (size_t i = named_terms_sizes.back(); i < named_terms.size(); i++)
+    term_names.erase(named_terms[i]);
+  named_terms.resize(named_terms_sizes.back());
+  named_terms_sizes.pop_back();
+
   smt_convt::pop_ctx();
 }
 
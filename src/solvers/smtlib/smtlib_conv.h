@@ -276,11 +276,13 @@ public:
   unsigned int
   emit_terminal_ast(const smtlib_smt_ast *a, std::string &output) const;
 
-  unsigned int emit_ast(
-    const smtlib_smt_ast *ast,
-    std::string &output,
-    std::unordered_map<const smtlib_smt_ast *, std::string> &temp_symbols)
-    const;
+  /* Text of ast as an operand: a terminal, the name a define-fun gave it or,
+   * if it has none, the function application itself. */
+  std::string term_string(const smtlib_smt_ast *ast) const;
+
+  /* Emits a define-fun for each function application in ast that has no
+   * name yet, operands first, and returns the text of ast. */
+  std::string define_terms(const smtlib_smt_ast *ast) const;
 
   void emit_ast(const smtlib_smt_ast *ast) const;
 
@@ -358,6 +360,13 @@ public:
 
   symbol_tablet symbol_table;
 
+  // Function applications named by a define-fun, in the order they were
+  // defined; (pop 1) forgets those of the popped level.
+  mutable std::unordered_map<const smtlib_smt_ast *, std::string> term_names;
+  mutable std::vector<const smtlib_smt_ast *> named_terms;
+  std::vector<size_t> named_terms_sizes;
+  mutable size_t num_term_names = 0;
+
   static const std::string temp_prefix;
 
   struct external_process_died : std::runtime_error
@@ -96,6 +96,11 @@ smt_convt::resultt z3_convt::dec_solve()
   return smt_convt::P_ERROR;
 }
 
+void z3_convt::interrupt()
+{
+  z3_ctx.interrupt();
+}
+
 void z3_convt::assert_ast(smt_astt a)
 {
   z3::expr theval = to_solver_smt_ast<z3_smt_ast>(a)->a;
@@ -2,6 +2,9 @@
 #include <util/message.h>
 #include <utility>
 #include <util/crypto_hash.h>
+#include <filesystem>
+#include <fstream>
+#include <random>
 
 void assertion_cache::run_on_assert(symex_target_equationt::SSA_stept &step)
 {
@@ -27,3 +30,112 @@ bool assertion_cache::run(symex_target_equationt::SSA_stepst &eq)
     total);
   return true;
 }
+
+// Options that change how results are reported or scheduled, but not the
+// result of a formula
+static const std::unordered_set<std::string> result_neutral_options = {
+  "result-cache",
+  "parallel-solving",
+  "parallel-jobs",
+  "parallel-memlimit",
+  "parallel-interleavings",
+  "parallel-frontend",
+  "python-ast-cache",
+  "color",
+  "verbosity",
+  "timeout",
+  "memlimit",
+  "enable-keep-alive",
+  "keep-alive-interval",
+  "cex-output",
+  "file-output",
+  "witness-output",
+  "witness-output-yaml",
+  "result-only"};
+
+result_cache::result_cache(
+  const std::string &dir,
+  const optionst &options,
+  const std::string &version)
+  : dir(dir), salt(version)
+{
+  for (const auto &[name, value] : options.option_map)
+    if (!result_neutral_options.count(name))
+      salt += "\n" + name + "=" + value;
+}
+
+std::string
+result_cache::key(const symex_target_equationt::SSA_stepst &steps) const
+{
+  crypto_hash hash;
+  hash.ingest(salt.data(), salt.size());
+
+  auto ingest = [&hash](const expr2tc &e) {
+    // Keep a missing expression apart from the next one
+    uint8_t is_nil = is_nil_expr(e);
+    hash.ingest(&is_nil, sizeof(is_nil));
+    if (!is_nil)
+      e->hash(hash);
+  };
+
+  for (const auto &step : steps)
+  {
+    if (step.ignore)
+      continue;
+
+    uint8_t type = step.type;
+    hash.ingest(&type, sizeof(type));
+    ingest(step.guard);
+
+    if (step.is_assignment() || step.is_assume() || step.is_assert())
+      ingest(step.cond);
+    else if (step.is_renumber())
+    {
+      ingest(step.lhs);
+      ingest(step.rhs);
+    }
+  }
+
+  hash.fin();
+  return hash.to_string();
+}
+
+std::string result_cache::path(const std::string &key) const
+{
+  // Fan out like git objects to keep the directories small
+  return (std::filesystem::path(dir) / key.substr(0, 2) / key.substr(2))
+    .string();
+}
+
+bool result_cache::is_unsat(const std::string &key) const
+{
+  std::ifstream in(path(key));
+  std::string result;
+  return in && std::getline(in, result) && result == "UNSAT";
+}
+
+void result_cache::store_unsat(const std::string &key) const
+{
+  const std::filesystem::path file = path(key);
+  std::error_code ec;
+  std::filesystem::create_directories(file.parent_path(), ec);
+
+  // Write to a temporary file first, so that concurrent runs sharing the
+  // directory never read a partial entry
+  std::filesystem::path tmp = file;
+  tmp += "." + std::to_string(std::random_device()()) + ".tmp";
+  {
+    std::ofstream out(tmp);
+    out << "UNSAT\n";
+    if (!out)
+    {
+      log_warning("Could not write to the result cache {}", dir);
+      std::filesystem::remove(tmp, ec);
+      return;
+    }
+  }
+
+  std::filesystem::rename(tmp, file, ec);
+  if (ec)
+    std::filesystem::remove(tmp, ec);
+}
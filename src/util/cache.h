@@ -1,11 +1,13 @@
 #pragma once
 
+#include <string>
 #include <unordered_set>
 
 #include <util/algorithms.h>
 #include <util/time_stopping.h>
 #include <util/crypto_hash.h>
 #include <util/cache_defs.h>
+#include <util/options.h>
 
 /**
  * @Brief This class stores all asserts conditions and guards
@@ -38,3 +40,36 @@ private:
   BigInt hits = 0;
   BigInt total = 0;
 };
+
+/**
+ * @Brief On-disk cache of verification results, shared between runs
+ *
+ * A formula is identified by a hash of its (not ignored) SSA steps, of the
+ * options it is checked with and of the ESBMC version. The cache directory
+ * holds one file per formula, named after that hash. Only UNSAT results are
+ * kept: a counterexample is built from the model of the solver, so formulas
+ * with a violation are always solved again.
+ */
+class result_cache
+{
+public:
+  result_cache(
+    const std::string &dir,
+    const optionst &options,
+    const std::string &version);
+
+  /// Hash of \steps, the options and the version, as a hex string
+  std::string key(const symex_target_equationt::SSA_stepst &steps) const;
+
+  /// Whether the formula with \key was proven UNSAT before
+  bool is_unsat(const std::string &key) const;
+
+  void store_unsat(const std::string &key) const;
+
+protected:
+  std::string dir;
+  /// options and version, hashed before the steps
+  std::string salt;
+
+  std::string path(const std::string &key) const;
+};
@@ -0,0 +1,254 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Map kept as a vector sorted by key.
+ *
+ * Meant for the small maps found in every node of a tree, where a std::map
+ * costs a heap node per entry plus the tree's own bookkeeping, and an empty
+ * map is larger than an empty vector. Lookups are binary searches over
+ * contiguous keys.
+ *
+ * The values are stored behind their own pointer so that, as with std::map,
+ * references to them stay valid when other keys are inserted or erased.
+ * Iterators are invalidated by any insertion or erasure. Dereferencing an
+ * iterator yields a pair of references to the key and the value.
+ */
+template <class Key, class T, class Compare = std::less<Key>>
+class flat_mapt
+{
+protected:
+  typedef std::pair<Key, std::unique_ptr<T>> slott;
+  typedef std::vector<slott> slotst;
+
+  template <class V, class SlotIt>
+  class iteratort
+  {
+  public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef std::pair<const Key &, V &> value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef value_type reference;
+
+    struct pointer
+    {
+      value_type entry;
+      const value_type *operator->() const
+      {
+        return &entry;
+      }
+    };
+
+    iteratort() = default;
+
+    explicit iteratort(SlotIt pos) : pos(pos)
+    {
+    }
+
+    // iterator -> const_iterator
+    template <class V2, class SlotIt2>
+    iteratort(const iteratort<V2, SlotIt2> &it) : pos(it.pos)
+    {
+    }
+
+    reference operator*() const
+    {
+      return reference(pos->first, *pos->second);
+    }
+
+    pointer operator->() const
+    {
+      return pointer{**this};
+    }
+
+    iteratort &operator++()
+    {
+      ++pos;
+      return *this;
+    }
+
+    iteratort operator++(int)
+    {
+      iteratort tmp = *this;
+      ++pos;
+      return tmp;
+    }
+
+    iteratort &operator--()
+    {
+      --pos;
+      return *this;
+    }
+
+    iteratort operator--(int)
+    {
+      iteratort tmp = *this;
+      --pos;
+      return tmp;
+    }
+
+    bool operator==(const iteratort &ref) const
+    {
+      return pos == ref.pos;
+    }
+
+    bool operator!=(const iteratort &ref) const
+    {
+      return pos != ref.pos;
+    }
+
+  protected:
+    friend class flat_mapt;
+    template <class, class>
+    friend class iteratort;
+
+    SlotIt pos;
+  };
+
+public:
+  typedef Key key_type;
+  typedef T mapped_type;
+  typedef iteratort<T, typename slotst::iterator> iterator;
+  typedef iteratort<const T, typename slotst::const_iterator> const_iterator;
+
+  flat_mapt() = default;
+  flat_mapt(flat_mapt &&) noexcept = default;
+  flat_mapt &operator=(flat_mapt &&) noexcept = default;
+
+  flat_mapt(const flat_mapt &ref)
+  {
+    slots.reserve(ref.slots.size());
+    for (const slott &s : ref.slots)
+      slots.emplace_back(s.first, std::make_unique<T>(*s.second));
+  }
+
+  flat_mapt &operator=(const flat_mapt &ref)
+  {
+    if (this != &ref)
+    {
+      flat_mapt tmp(ref);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  size_t size() const
+  {
+    return slots.size();
+  }
+
+  bool empty() const
+  {
+    return slots.empty();
+  }
+
+  void clear()
+  {
+    slots.clear();
+  }
+
+  void swap(flat_mapt &ref)
+  {
+    slots.swap(ref.slots);
+  }
+
+  iterator begin()
+  {
+    return iterator(slots.begin());
+  }
+
+  iterator end()
+  {
+    return iterator(slots.end());
+  }
+
+  const_iterator begin() const
+  {
+    return const_iterator(slots.begin());
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator(slots.end());
+  }
+
+  iterator find(const Key &key)
+  {
+    auto it = lower_bound(slots, key);
+    if (it == slots.end() || Compare()(key, it->first))
+      return end();
+    return iterator(it);
+  }
+
+  const_iterator find(const Key &key) const
+  {
+    auto it = lower_bound(slots, key);
+    if (it == slots.end() || Compare()(key, it->first))
+      return end();
+    return const_iterator(it);
+  }
+
+  size_t count(const Key &key) const
+  {
+    return find(key) == end() ? 0 : 1;
+  }
+
+  /// Value for key, inserting a default constructed one if it's not present
+  T &operator[](const Key &key)
+  {
+    auto it = lower_bound(slots, key);
+    if (it == slots.end() || Compare()(key, it->first))
+      it = slots.emplace(it, key, std::make_unique<T>());
+    return *it->second;
+  }
+
+  iterator erase(const_iterator it)
+  {
+    return iterator(slots.erase(it.pos));
+  }
+
+  size_t erase(const Key &key)
+  {
+    const_iterator it = find(key);
+    if (it == end())
+      return 0;
+    erase(it);
+    return 1;
+  }
+
+  bool operator==(const flat_mapt &ref) const
+  {
+    return std::equal(
+      slots.begin(),
+      slots.end(),
+      ref.slots.begin(),
+      ref.slots.end(),
+      [](const slott &a, const slott &b) {
+        return a.first == b.first && *a.second == *b.second;
+      });
+  }
+
+  bool operator!=(const flat_mapt &ref) const
+  {
+    return !(*this == ref);
+  }
+
+protected:
+  slotst slots;
+
+  template <class Slots>
+  static auto lower_bound(Slots &slots, const Key &key)
+  {
+    return std::lower_bound(
+      slots.begin(), slots.end(), key, [](const slott &s, const Key &k) {
+        return Compare()(s.first, k);
+      });
+  }
+};
@@ -44,19 +44,12 @@ void irept::detatch()
     return;
   }
 
+  // Only this irept refers to the data, so nobody else can add a reference
   dt *const old_data = data;
-  old_data->dt_mutex.lock();
-  if (old_data->ref_count == 1)
-  {
-    old_data->dt_mutex.unlock();
+  if (old_data->ref_count.load(std::memory_order_acquire) == 1)
     return;
-  }
-  dt *new_data = new dt(*old_data);
-  this->data = new_data;
-
-  data->ref_count = 1;
 
-  old_data->dt_mutex.unlock();
+  data = new dt(*old_data);
   remove_ref(old_data);
 }
 #endif
@@ -74,25 +67,13 @@ const irept::dt &irept::read() const
 #ifdef SHARING
 void irept::remove_ref(dt *old_data)
 {
-  bool should_delete = false;
-
   if (old_data == nullptr)
     return;
 
-  {
-    // Lock the data block we are about to modify.
-    std::lock_guard<std::mutex> lock(old_data->dt_mutex);
-    assert(old_data->ref_count > 0);
-    old_data->ref_count--;
-    if (old_data->ref_count == 0)
-      should_delete = true;
-  }
-
-  // Delete the data after releasing the lock.
-  if (should_delete)
-  {
+  // Release our writes to the data, and see everybody else's before deleting
+  // it
+  if (old_data->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
     delete old_data;
-  }
 }
 #endif
 
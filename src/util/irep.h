@@ -1,10 +1,12 @@
 #ifndef CPROVER_IREP_H
 #define CPROVER_IREP_H
 
+#include <atomic>
 #include <cassert>
 #include <list>
 #include <map>
 #include <string>
+#include <util/flat_map.h>
 #include <vector>
 
 #define USE_DSTRING
@@ -40,7 +42,8 @@ public:
   typedef std::vector<irept> subt;
   //typedef std::list<irept> subt;
 
-  typedef std::map<irep_namet, irept> named_subt;
+  // Most ireps have a handful of named operands, if any
+  typedef flat_mapt<irep_namet, irept> named_subt;
 
   // Dump contents of irep to stdout. Debugging only.
   void dump() const;
@@ -61,19 +64,11 @@ public:
   {
   }
 
-  inline irept(const irept &irep)
+  inline irept(const irept &irep) : data(irep.data)
   {
-    // We only need to lock the source's data to safely read the pointer
-    // and increment its reference count.
-    dt *source_data = nullptr;
-    if (irep.data)
-    {
-      std::lock_guard<std::mutex> lock(irep.data->dt_mutex);
-      source_data = irep.data;
-      if (source_data)
-        source_data->ref_count++;
-    }
-    data = source_data;
+    // The source holds a reference, so the count can't drop to zero here
+    if (data)
+      data->ref_count.fetch_add(1, std::memory_order_relaxed);
   }
 
   inline irept &operator=(const irept &irep)
@@ -81,14 +76,9 @@ public:
     if (this == &irep)
       return *this;
 
-    dt *new_data = nullptr;
-    if (irep.data)
-    {
-      std::lock_guard<std::mutex> lock(irep.data->dt_mutex);
-      new_data = irep.data;
-      if (new_data)
-        new_data->ref_count++;
-    }
+    dt *new_data = irep.data;
+    if (new_data)
+      new_data->ref_count.fetch_add(1, std::memory_order_relaxed);
 
     dt *old_data = data;
     data = new_data;
@@ -1303,8 +1293,7 @@ public:
   {
   public:
 #ifdef SHARING
-    unsigned ref_count;
-    mutable std::mutex dt_mutex;
+    std::atomic<unsigned> ref_count;
 #endif
 
     dstring data;
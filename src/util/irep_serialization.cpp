@@ -31,17 +31,20 @@ void irep_serializationt::write_irep(std::ostream &out, const irept &irep)
 void irep_serializationt::reference_convert(std::istream &in, irept &irep)
 {
   unsigned id = read_long(in);
+  irep_serializationt::ireps_containert::irepts_on_readt &on_read =
+    ireps_container.ireps_on_read;
 
-  if (
-    ireps_container.ireps_on_read.find(id) !=
-    ireps_container.ireps_on_read.end())
+  if (id < on_read.size() && on_read[id].first)
   {
-    irep = ireps_container.ireps_on_read[id];
+    irep = on_read[id].second;
   }
   else
   {
     read_irep(in, irep);
-    ireps_container.ireps_on_read[id] = irep;
+    // Numbers are given out in order, so the vector stays dense
+    if (id >= on_read.size())
+      on_read.resize(id + 1);
+    on_read[id] = {true, irep};
   }
 }
 
@@ -174,3 +177,139 @@ irep_idt irep_serializationt::read_string_ref(std::istream &in)
   ireps_container.string_rev_map[id] = std::pair<bool, dstring>(true, s);
   return ireps_container.string_rev_map[id].second;
 }
+
+unsigned irep_string_tablet::add(const irep_idt &s)
+{
+  auto [it, inserted] = numbers.try_emplace(s, strings.size());
+  if (inserted)
+    strings.push_back(s);
+  return it->second;
+}
+
+void irep_string_tablet::write(std::ostream &out) const
+{
+  irep_section_serializationt::write_varint(out, strings.size());
+  for (const irep_idt &s : strings)
+  {
+    const std::string &str = s.as_string();
+    irep_section_serializationt::write_varint(out, str.size());
+    out.write(str.data(), str.size());
+  }
+}
+
+bool irep_string_tablet::read(std::istream &in)
+{
+  unsigned count = irep_section_serializationt::read_varint(in);
+  std::string str;
+  for (unsigned i = 0; i < count && in.good(); i++)
+  {
+    str.resize(irep_section_serializationt::read_varint(in));
+    in.read(str.data(), str.size());
+    add(irep_idt(str));
+  }
+  return !in.good() || strings.size() != count;
+}
+
+void irep_section_serializationt::write_varint(std::ostream &out, unsigned u)
+{
+  // 7 bits at a time, least significant first; the top bit marks that more
+  // bytes follow
+  while (u >= 0x80)
+  {
+    out.put(char((u & 0x7f) | 0x80));
+    u >>= 7;
+  }
+  out.put(char(u));
+}
+
+unsigned irep_section_serializationt::read_varint(std::istream &in)
+{
+  unsigned res = 0;
+  for (unsigned shift = 0; shift < 32 && in.good(); shift += 7)
+  {
+    int c = in.get();
+    if (c == EOF)
+      break;
+    res |= unsigned(c & 0x7f) << shift;
+    if (!(c & 0x80))
+      break;
+  }
+  return res;
+}
+
+void irep_section_serializationt::write_string_ref(
+  std::ostream &out,
+  const irep_idt &s)
+{
+  write_varint(out, strings.add(s));
+}
+
+irep_idt irep_section_serializationt::read_string_ref(std::istream &in)
+{
+  return strings.get(read_varint(in));
+}
+
+void irep_section_serializationt::write(std::ostream &out, const irept &irep)
+{
+  // Numbers are given out in the order ireps are first written, so the
+  // reader can tell a new irep from a reference to an earlier one
+  unsigned n = written.size();
+  auto [pos, inserted] = written.try_emplace(irep, n);
+  write_varint(out, pos->second);
+  if (!inserted)
+    return;
+
+  write_string_ref(out, irep.id());
+
+  write_varint(out, irep.get_sub().size());
+  forall_irep (it, irep.get_sub())
+    write(out, *it);
+
+  write_varint(out, irep.get_named_sub().size());
+  forall_named_irep (it, irep.get_named_sub())
+  {
+    write_string_ref(out, it->first);
+    write(out, it->second);
+  }
+
+  write_varint(out, irep.get_comments().size());
+  forall_named_irep (it, irep.get_comments())
+  {
+    write_string_ref(out, it->first);
+    write(out, it->second);
+  }
+}
+
+void irep_section_serializationt::read(std::istream &in, irept &irep)
+{
+  unsigned n = read_varint(in);
+  if (n < ireps_read.size())
+  {
+    irep = ireps_read[n];
+    return;
+  }
+
+  if (n != ireps_read.size() || !in.good())
+  {
+    assert(0 && "irep not numbered in order");
+    abort();
+  }
+  // Claim the number before reading the operands, which come after it
+  ireps_read.emplace_back();
+
+  irep = irept(read_string_ref(in));
+
+  for (unsigned count = read_varint(in); count != 0; count--)
+  {
+    irep.get_sub().emplace_back();
+    read(in, irep.get_sub().back());
+  }
+
+  // Named operands and comments are told apart by their names
+  for (unsigned count = read_varint(in); count != 0; count--)
+    read(in, irep.add(read_string_ref(in)));
+  for (unsigned count = read_varint(in); count != 0; count--)
+    read(in, irep.add(read_string_ref(in)));
+
+  ireps_read[n] = irep;
+}
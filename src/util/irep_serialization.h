@@ -2,7 +2,9 @@
 #define IREP_SERIALIZATION_H_
 
 #include <map>
+#include <unordered_map>
 #include <util/irep.h>
+#include <vector>
 
 void write_long(std::ostream &, unsigned);
 void write_string(std::ostream &, const std::string &);
@@ -50,7 +52,8 @@ public:
   class ireps_containert
   {
   public:
-    typedef std::map<unsigned, irept> irepts_on_readt;
+    /// Indexed by the number of the irep; the flag tells whether it was read
+    typedef std::vector<std::pair<bool, irept>> irepts_on_readt;
     irepts_on_readt ireps_on_read;
 
     typedef std::unordered_map<irept, unsigned, irep_full_hash, irep_full_eq>
@@ -100,4 +103,57 @@ private:
   void read_irep(std::istream &, irept &irep);
 };
 
+/**
+ * Strings of a goto binary, written once at its start and referred to by
+ * their position everywhere else.
+ */
+class irep_string_tablet
+{
+public:
+  unsigned add(const irep_idt &s);
+
+  const irep_idt &get(unsigned n) const
+  {
+    return strings.at(n);
+  }
+
+  void write(std::ostream &) const;
+  /// @return true on error
+  bool read(std::istream &);
+
+private:
+  std::vector<irep_idt> strings;
+  std::unordered_map<irep_idt, unsigned, irep_id_hash> numbers;
+};
+
+/**
+ * Compact encoding of the ireps of one section of a goto binary. Numbers are
+ * variable-length and strings refer to the binary's string table. Equal
+ * ireps are only written once, but only within the section, so that every
+ * section can be read without reading the others. Use a new object for
+ * every section.
+ */
+class irep_section_serializationt
+{
+public:
+  explicit irep_section_serializationt(irep_string_tablet &strings)
+    : strings(strings)
+  {
+  }
+
+  void write(std::ostream &, const irept &irep);
+  void read(std::istream &, irept &irep);
+
+  static void write_varint(std::ostream &, unsigned);
+  static unsigned read_varint(std::istream &);
+
+private:
+  irep_string_tablet &strings;
+  std::unordered_map<irept, unsigned, irep_full_hash, irep_full_eq> written;
+  std::vector<irept> ireps_read;
+
+  void write_string_ref(std::ostream &, const irep_idt &s);
+  irep_idt read_string_ref(std::istream &);
+};
+
 #endif /*IREP_SERIALIZATION_H_*/
@@ -18,6 +18,15 @@ public:
   // parse file
   virtual bool parse(const std::string &path) = 0;
 
+  // parse several files, by default one after the other
+  virtual bool parse_files(const std::vector<std::string> &paths)
+  {
+    for (const std::string &path : paths)
+      if (parse(path))
+        return true;
+    return false;
+  }
+
   // final adjustments, e.g., initialization and call to main()
   virtual bool final(contextt &)
   {
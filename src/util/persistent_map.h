@@ -0,0 +1,423 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Hash map whose copies share their storage.
+ *
+ * The map is a hash array mapped trie: every node has 32 slots, selected by
+ * 5 bits of the hash of the key, each holding either an entry or a child
+ * node. Copying the map only copies the pointer to its root, in O(1).
+ * Modifying it first copies the nodes on the path to the modified entry that
+ * are still shared with another copy, so each copy only pays for the parts
+ * in which it differs from the others.
+ *
+ * Entries are stored behind their own pointer, so copying a node never
+ * copies keys or values and values are never assigned to.
+ *
+ * Iteration order is unspecified. Iterators and references to values are
+ * invalidated by any modification of the map.
+ */
+template <
+  class Key,
+  class T,
+  class Hash = std::hash<Key>,
+  class KeyEqual = std::equal_to<Key>>
+class persistent_mapt
+{
+public:
+  typedef Key key_type;
+  typedef T mapped_type;
+  typedef std::pair<Key, T> value_type;
+
+protected:
+  static constexpr unsigned bits = 5;
+  static constexpr unsigned width = 1u << bits;
+  /// Depth at which all the bits of the hash have been used up. Nodes at this
+  /// depth just hold a list of entries whose keys have the same hash.
+  static constexpr unsigned max_depth =
+    (sizeof(size_t) * 8 + bits - 1) / bits;
+
+  typedef std::shared_ptr<value_type> entry_ptrt;
+
+  struct nodet
+  {
+    /// Slots holding an entry and slots holding a child. Both entries and
+    /// children are stored in the order of their slots.
+    uint32_t entry_map = 0;
+    uint32_t child_map = 0;
+    std::vector<entry_ptrt> entries;
+    std::vector<std::shared_ptr<nodet>> children;
+  };
+  typedef std::shared_ptr<nodet> node_ptrt;
+
+  static unsigned slot_bit(size_t hash, unsigned depth)
+  {
+    return 1u << ((hash >> (depth * bits)) & (width - 1));
+  }
+
+  /// Position of the element for slot `bit` among those present in `map`
+  static unsigned index(uint32_t map, uint32_t bit)
+  {
+    return std::bitset<width>(map & (bit - 1)).count();
+  }
+
+public:
+  class const_iterator
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename persistent_mapt::value_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const value_type *pointer;
+    typedef const value_type &reference;
+
+    const_iterator() = default;
+
+    reference operator*() const
+    {
+      const framet &f = stack[depth - 1];
+      return *f.node->entries[f.pos];
+    }
+
+    pointer operator->() const
+    {
+      return &**this;
+    }
+
+    const_iterator &operator++()
+    {
+      stack[depth - 1].pos++;
+      settle();
+      return *this;
+    }
+
+    const_iterator operator++(int)
+    {
+      const_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    bool operator==(const const_iterator &ref) const
+    {
+      if (depth == 0 || ref.depth == 0)
+        return depth == ref.depth;
+      return &**this == &*ref;
+    }
+
+    bool operator!=(const const_iterator &ref) const
+    {
+      return !(*this == ref);
+    }
+
+  protected:
+    friend class persistent_mapt;
+
+    /// A node being visited and the position in it: entries come first,
+    /// then the children. All frames but the last point to a child.
+    struct framet
+    {
+      const nodet *node;
+      size_t pos;
+    };
+    std::array<framet, max_depth + 1> stack;
+    unsigned depth = 0;
+
+    void push(const nodet *node, size_t pos)
+    {
+      stack[depth++] = {node, pos};
+    }
+
+    /// Moves forward until the last frame points to an entry
+    void settle()
+    {
+      while (depth != 0)
+      {
+        framet &f = stack[depth - 1];
+        size_t num_entries = f.node->entries.size();
+        if (f.pos < num_entries)
+          return;
+
+        size_t child = f.pos - num_entries;
+        if (child < f.node->children.size())
+        {
+          push(f.node->children[child].get(), 0);
+          continue;
+        }
+
+        depth--;
+        if (depth != 0)
+          stack[depth - 1].pos++;
+      }
+    }
+  };
+
+  typedef const_iterator iterator;
+
+  persistent_mapt() = default;
+
+  size_t size() const
+  {
+    return num_entries;
+  }
+
+  bool empty() const
+  {
+    return num_entries == 0;
+  }
+
+  void clear()
+  {
+    root.reset();
+    num_entries = 0;
+  }
+
+  const_iterator begin() const
+  {
+    const_iterator it;
+    if (root)
+    {
+      it.push(root.get(), 0);
+      it.settle();
+    }
+    return it;
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator();
+  }
+
+  const_iterator find(const Key &key) const
+  {
+    const_iterator it;
+    size_t hash = Hash()(key);
+    const nodet *n = root.get();
+    for (unsigned depth = 0; n != nullptr; depth++)
+    {
+      if (depth == max_depth)
+      {
+        for (size_t i = 0; i < n->entries.size(); i++)
+          if (KeyEqual()(n->entries[i]->first, key))
+          {
+            it.push(n, i);
+            return it;
+          }
+        break;
+      }
+
+      uint32_t bit = slot_bit(hash, depth);
+      if (n->entry_map & bit)
+      {
+        unsigned i = index(n->entry_map, bit);
+        if (!KeyEqual()(n->entries[i]->first, key))
+          break;
+        it.push(n, i);
+        return it;
+      }
+
+      if (!(n->child_map & bit))
+        break;
+
+      unsigned c = index(n->child_map, bit);
+      it.push(n, n->entries.size() + c);
+      n = n->children[c].get();
+    }
+    return end();
+  }
+
+  size_t count(const Key &key) const
+  {
+    return find(key) == end() ? 0 : 1;
+  }
+
+  /**
+   * Inserts `value` unless its key is already present.
+   * @return The value stored for the key, which may be modified until the
+   *         next modification of the map, and whether it was inserted.
+   */
+  std::pair<T *, bool> insert(const value_type &value)
+  {
+    size_t hash = Hash()(value.first);
+    node_ptrt *p = &root;
+    for (unsigned depth = 0;; depth++)
+    {
+      nodet &n = unshare(*p);
+
+      if (depth == max_depth)
+      {
+        for (entry_ptrt &e : n.entries)
+          if (KeyEqual()(e->first, value.first))
+            return {&unshare(e).second, false};
+        n.entries.push_back(std::make_shared<value_type>(value));
+        num_entries++;
+        return {&n.entries.back()->second, true};
+      }
+
+      uint32_t bit = slot_bit(hash, depth);
+      if (n.child_map & bit)
+      {
+        p = &n.children[index(n.child_map, bit)];
+        continue;
+      }
+
+      unsigned i = index(n.entry_map, bit);
+      if (!(n.entry_map & bit))
+      {
+        n.entry_map |= bit;
+        n.entries.insert(
+          n.entries.begin() + i, std::make_shared<value_type>(value));
+        num_entries++;
+        return {&n.entries[i]->second, true};
+      }
+
+      if (KeyEqual()(n.entries[i]->first, value.first))
+        return {&unshare(n.entries[i]).second, false};
+
+      // Slot taken by another key: move that entry into a new child node and
+      // carry on from there
+      node_ptrt child = std::make_shared<nodet>();
+      add_to_empty(*child, std::move(n.entries[i]), depth + 1);
+      n.entries.erase(n.entries.begin() + i);
+      n.entry_map &= ~bit;
+
+      unsigned c = index(n.child_map, bit);
+      n.child_map |= bit;
+      n.children.insert(n.children.begin() + c, std::move(child));
+      p = &n.children[c];
+    }
+  }
+
+  /// Value for key, inserting a default constructed one if it's not present
+  T &operator[](const Key &key)
+  {
+    return *insert(value_type(key, T())).first;
+  }
+
+  size_t erase(const Key &key)
+  {
+    // Don't copy the path to an entry that isn't there
+    if (find(key) == end())
+      return 0;
+
+    erase_rec(root, key, Hash()(key), 0);
+    num_entries--;
+    return 1;
+  }
+
+  /**
+   * Calls `f(entry, other_value)` for the entries of this map that may not be
+   * in `other`, where `other_value` is the value of the same key in `other`
+   * or nullptr if `other` doesn't have it. Nodes that both maps still share
+   * are skipped, so this is cheap for maps copied from each other.
+   */
+  template <class F>
+  void for_each_difference(const persistent_mapt &other, F &&f) const
+  {
+    difference_rec(root.get(), other.root.get(), other, f);
+  }
+
+protected:
+  node_ptrt root;
+  size_t num_entries = 0;
+
+  template <class U>
+  static U &unshare(std::shared_ptr<U> &p)
+  {
+    if (!p)
+      p = std::make_shared<U>();
+    else if (p.use_count() != 1)
+      p = std::make_shared<U>(*p);
+    return *p;
+  }
+
+  static void add_to_empty(nodet &n, entry_ptrt entry, unsigned depth)
+  {
+    if (depth != max_depth)
+      n.entry_map = slot_bit(Hash()(entry->first), depth);
+    n.entries.push_back(std::move(entry));
+  }
+
+  /// Removes key, which must be present below p. Returns true and resets p if
+  /// that left the node empty.
+  static bool
+  erase_rec(node_ptrt &p, const Key &key, size_t hash, unsigned depth)
+  {
+    nodet &n = unshare(p);
+
+    if (depth == max_depth)
+    {
+      for (size_t i = 0; i < n.entries.size(); i++)
+        if (KeyEqual()(n.entries[i]->first, key))
+        {
+          n.entries.erase(n.entries.begin() + i);
+          break;
+        }
+    }
+    else
+    {
+      uint32_t bit = slot_bit(hash, depth);
+      if (n.entry_map & bit)
+      {
+        n.entries.erase(n.entries.begin() + index(n.entry_map, bit));
+        n.entry_map &= ~bit;
+      }
+      else
+      {
+        unsigned c = index(n.child_map, bit);
+        if (erase_rec(n.children[c], key, hash, depth + 1))
+        {
+          n.children.erase(n.children.begin() + c);
+          n.child_map &= ~bit;
+        }
+      }
+    }
+
+    if (!n.entries.empty() || !n.children.empty())
+      return false;
+
+    p.reset();
+    return true;
+  }
+
+  template <class F>
+  static void difference_rec(
+    const nodet *n,
+    const nodet *other_n,
+    const persistent_mapt &other,
+    F &f)
+  {
+    if (n == nullptr || n == other_n)
+      return;
+
+    for (const entry_ptrt &e : n->entries)
+    {
+      const_iterator it = other.find(e->first);
+      if (it == other.end())
+        f(*e, static_cast<const T *>(nullptr));
+      else if (&*it != e.get())
+        f(*e, &it->second);
+    }
+
+    for (unsigned slot = 0, c = 0; c < n->children.size(); slot++)
+    {
+      uint32_t bit = 1u << slot;
+      if (!(n->child_map & bit))
+        continue;
+
+      const nodet *other_child = nullptr;
+      if (other_n != nullptr && (other_n->child_map & bit))
+        other_child = other_n->children[index(other_n->child_map, bit)].get();
+
+      difference_rec(n->children[c++].get(), other_child, other, f);
+    }
+  }
+};
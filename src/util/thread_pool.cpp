@@ -0,0 +1,145 @@
+#include <util/thread_pool.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+#ifndef _WIN32
+#  include <unistd.h>
+#endif
+
+uint64_t get_resident_set_size()
+{
+#ifdef __linux__
+  // The second field of statm is the number of resident pages
+  std::ifstream statm("/proc/self/statm");
+  uint64_t size = 0, resident = 0;
+  if (!(statm >> size >> resident))
+    return 0;
+  return resident * (uint64_t)sysconf(_SC_PAGESIZE);
+#else
+  return 0;
+#endif
+}
+
+thread_poolt::thread_poolt(size_t num_workers, uint64_t memory_budget)
+  : memory_budget(memory_budget)
+{
+  if (num_workers == 0)
+    num_workers = std::max(1u, std::thread::hardware_concurrency());
+
+  for (size_t i = 0; i < num_workers; i++)
+    queues.push_back(std::make_unique<work_queuet>());
+}
+
+thread_poolt::~thread_poolt()
+{
+  for (auto &t : workers)
+    if (t.joinable())
+      t.join();
+}
+
+void thread_poolt::submit(taskt task)
+{
+  size_t id;
+  {
+    std::lock_guard lock(state_mutex);
+    ++pending;
+    ++queued;
+    id = next_queue++ % queues.size();
+  }
+
+  {
+    std::lock_guard lock(queues[id]->mutex);
+    queues[id]->tasks.push_back(std::move(task));
+  }
+
+  state_cv.notify_one();
+}
+
+void thread_poolt::wait()
+{
+  if (workers.empty())
+    for (size_t i = 0; i < queues.size(); i++)
+      workers.emplace_back(&thread_poolt::worker_loop, this, i);
+
+  for (auto &t : workers)
+    t.join();
+  workers.clear();
+}
+
+bool thread_poolt::pop_task(size_t id, taskt &task)
+{
+  bool found = false;
+
+  // Own queue first, cheapest task at the front
+  {
+    std::lock_guard lock(queues[id]->mutex);
+    if (!queues[id]->tasks.empty())
+    {
+      task = std::move(queues[id]->tasks.front());
+      queues[id]->tasks.pop_front();
+      found = true;
+    }
+  }
+
+  // Otherwise steal from the back of somebody else's queue
+  for (size_t i = 1; !found && i < queues.size(); i++)
+  {
+    work_queuet &victim = *queues[(id + i) % queues.size()];
+    std::lock_guard lock(victim.mutex);
+    if (!victim.tasks.empty())
+    {
+      task = std::move(victim.tasks.back());
+      victim.tasks.pop_back();
+      found = true;
+    }
+  }
+
+  if (found)
+  {
+    std::lock_guard lock(state_mutex);
+    --queued;
+  }
+  return found;
+}
+
+void thread_poolt::admit()
+{
+  std::unique_lock lock(state_mutex);
+
+  // Never block when nothing else is running, otherwise we could wait
+  // forever for memory that is held by ourselves
+  while (
+    memory_budget != 0 && running != 0 &&
+    get_resident_set_size() > memory_budget)
+    state_cv.wait_for(lock, std::chrono::milliseconds(100));
+
+  ++running;
+}
+
+void thread_poolt::worker_loop(size_t id)
+{
+  for (;;)
+  {
+    taskt task;
+    if (pop_task(id, task))
+    {
+      admit();
+      task();
+
+      {
+        std::lock_guard lock(state_mutex);
+        --running;
+        --pending;
+      }
+      state_cv.notify_all();
+      continue;
+    }
+
+    std::unique_lock lock(state_mutex);
+    state_cv.wait(lock, [this] { return pending == 0 || queued != 0; });
+    if (pending == 0)
+      return;
+  }
+}
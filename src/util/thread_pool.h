@@ -0,0 +1,82 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Returns the resident set size of the current process in bytes,
+ *        or 0 if it cannot be determined on this platform.
+ */
+uint64_t get_resident_set_size();
+
+/**
+ * @brief Bounded work-stealing pool of worker threads.
+ *
+ * Every worker owns a deque of tasks. A worker takes tasks from the front
+ * of its own deque and, when that is empty, steals from the back of the
+ * other workers' deques. Tasks submitted before `wait()` are distributed
+ * round-robin, so submitting them in ascending order of cost makes each
+ * worker process its cheapest tasks first.
+ *
+ * When a memory budget is given, a worker will not start a new task while
+ * the resident set size of the process is above that budget and some other
+ * task is still running; it waits for a running task to finish instead.
+ */
+class thread_poolt
+{
+public:
+  typedef std::function<void()> taskt;
+
+  /**
+   * @param num_workers maximum number of tasks running at the same time,
+   *        0 means one per hardware thread
+   * @param memory_budget RSS in bytes above which no new task is admitted,
+   *        0 disables memory-aware admission
+   */
+  explicit thread_poolt(size_t num_workers, uint64_t memory_budget = 0);
+  thread_poolt(const thread_poolt &) = delete;
+  thread_poolt &operator=(const thread_poolt &) = delete;
+  ~thread_poolt();
+
+  /// Adds a task to the pool; may also be called from inside a task
+  void submit(taskt task);
+
+  /// Starts the workers (if needed) and blocks until every task has finished
+  void wait();
+
+  size_t num_workers() const
+  {
+    return queues.size();
+  }
+
+private:
+  struct work_queuet
+  {
+    std::mutex mutex;
+    std::deque<taskt> tasks;
+  };
+
+  std::vector<std::unique_ptr<work_queuet>> queues;
+  std::vector<std::thread> workers;
+  const uint64_t memory_budget;
+
+  std::mutex state_mutex;
+  std::condition_variable state_cv;
+  /// tasks submitted but not finished yet
+  size_t pending = 0;
+  /// tasks waiting in one of the queues
+  size_t queued = 0;
+  /// tasks currently being executed
+  size_t running = 0;
+  size_t next_queue = 0;
+
+  void worker_loop(size_t id);
+  bool pop_task(size_t id, taskt &task);
+  void admit();
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 128-bit hash of a set of (key, value) pairs that can be updated
+ *        incrementally.
+ *
+ * Every pair is mapped to a pseudo-random 128-bit key and the hash of the
+ * set is the XOR of the keys of its members. Adding or removing a pair is
+ * then a single XOR, whatever the size of the set, and the order in which
+ * pairs were added doesn't matter.
+ */
+class zobrist_hasht
+{
+public:
+  zobrist_hasht() = default;
+
+  /// Key for the pair (a, b), where a and b are hashes of its members
+  static zobrist_hasht key(size_t a, size_t b)
+  {
+    zobrist_hasht h;
+    h.lo = mix(uint64_t(a) + mix(uint64_t(b)));
+    h.hi = mix(uint64_t(b) + mix(uint64_t(a) ^ 0x2545f4914f6cdd1dULL));
+    return h;
+  }
+
+  /// Key for the pair (a, digest), where digest is a cryptographic hash of
+  /// the value. Unlike key(a, b), all of the digest's bits go into the key.
+  static zobrist_hasht key(size_t a, const void *digest, size_t size)
+  {
+    // Fold the digest, 8 bytes at a time, into two words
+    uint64_t words[2] = {0, 0};
+    const unsigned char *bytes = static_cast<const unsigned char *>(digest);
+    for (size_t i = 0; i < size; i += 8)
+    {
+      uint64_t chunk = 0;
+      for (size_t j = i; j < size && j < i + 8; j++)
+        chunk |= uint64_t(bytes[j]) << (8 * (j - i));
+      uint64_t &word = words[(i / 8) % 2];
+      word = mix(word ^ chunk);
+    }
+
+    zobrist_hasht h;
+    h.lo = mix(uint64_t(a) + mix(words[0]));
+    h.hi = mix(words[1] + mix(uint64_t(a) ^ 0x2545f4914f6cdd1dULL));
+    return h;
+  }
+
+  zobrist_hasht &operator^=(const zobrist_hasht &h)
+  {
+    lo ^= h.lo;
+    hi ^= h.hi;
+    return *this;
+  }
+
+  zobrist_hasht operator^(const zobrist_hasht &h) const
+  {
+    zobrist_hasht result = *this;
+    result ^= h;
+    return result;
+  }
+
+  bool operator==(const zobrist_hasht &h) const
+  {
+    return lo == h.lo && hi == h.hi;
+  }
+
+  bool operator!=(const zobrist_hasht &h) const
+  {
+    return !(*this == h);
+  }
+
+  size_t to_size_t() const
+  {
+    return lo;
+  }
+
+  struct hash
+  {
+    size_t operator()(const zobrist_hasht &h) const
+    {
+      return h.to_size_t();
+    }
+  };
+
+protected:
+  uint64_t lo = 0;
+  uint64_t hi = 0;
+
+  /// splitmix64 finaliser: spreads every input bit over the whole output
+  static uint64_t mix(uint64_t x)
+  {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  }
+};
@@ -0,0 +1,104 @@
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <c2goto/cprover_library.h>
+#include <util/config.h>
+#include <util/context.h>
+#include <util/language.h>
+#include <util/migrate.h>
+#include <util/std_types.h>
+
+namespace
+{
+/// Only tells add_cprover_library() that the program is in Python
+class python_languaget : public languaget
+{
+public:
+  bool parse(const std::string &) override
+  {
+    return false;
+  }
+
+  bool typecheck(contextt &, const std::string &) override
+  {
+    return false;
+  }
+
+  std::string id() const override
+  {
+    return "python";
+  }
+
+  void show_parse(std::ostream &) override
+  {
+  }
+
+  languaget *new_language() const override
+  {
+    return new python_languaget;
+  }
+
+protected:
+  bool from_expr(const exprt &, std::string &, const namespacet &, unsigned)
+    override
+  {
+    return true;
+  }
+
+  bool from_type(const typet &, std::string &, const namespacet &, unsigned)
+    override
+  {
+    return true;
+  }
+};
+
+/// A C program that calls the library function \name
+void declare(contextt &context, const std::string &name)
+{
+  symbolt symbol;
+  symbol.id = "c:@F@" + name;
+  symbol.name = name;
+  symbol.mode = "C";
+  symbol.type = code_typet();
+  context.add(symbol);
+}
+
+bool defines(const contextt &context, const std::string &name)
+{
+  const symbolt *symbol = context.find_symbol("c:@F@" + name);
+  return symbol != nullptr && symbol->value.is_not_nil();
+}
+} // namespace
+
+TEST_CASE(
+  "The Python models and the C library are read apart",
+  "[c2goto][library]")
+{
+  config.ansi_c.set_data_model(configt::LP64);
+  config.ansi_c.lib = configt::ansi_ct::LIB_FULL;
+  config.ansi_c.cheri = configt::ansi_ct::CHERI_OFF;
+  config.ansi_c.use_fixed_for_float = false;
+
+  // Reading a goto binary migrates the function bodies
+  contextt empty;
+  namespacet ns(empty);
+  migrate_namespace_lookup = &ns;
+
+  // The library is read once per process, so the order matters: C first
+  contextt c;
+  declare(c, "strcpy");
+  add_cprover_library(c);
+  REQUIRE(defines(c, "strcpy"));
+
+  // strcpy is not one of the Python models
+  python_languaget python;
+  contextt py;
+  add_cprover_library(py, &python);
+  REQUIRE(defines(py, "strlen"));
+  REQUIRE(py.find_symbol("c:@F@strcpy") == nullptr);
+
+  // Reading the models did not narrow the library C programs get
+  contextt c_again;
+  declare(c_again, "strcpy");
+  add_cprover_library(c_again);
+  REQUIRE(defines(c_again, "strcpy"));
+}
@@ -0,0 +1,472 @@
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <goto-symex/slice.h>
+#include <irep2/irep2_utils.h>
+
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace
+{
+const type2tc &u32()
+{
+  static const type2tc t = get_uint_type(32);
+  return t;
+}
+
+expr2tc sym(const std::string &name)
+{
+  return symbol2tc(u32(), name);
+}
+
+expr2tc num(unsigned n)
+{
+  return constant_int2tc(u32(), BigInt(n));
+}
+
+void assign(symex_target_equationt &eq, const expr2tc &lhs, const expr2tc &rhs)
+{
+  eq.assignment(
+    gen_true_expr(),
+    lhs,
+    lhs,
+    rhs,
+    rhs,
+    symex_targett::sourcet(),
+    {},
+    false,
+    0);
+}
+
+void check(
+  symex_target_equationt &eq,
+  const expr2tc &cond,
+  const symex_targett::sourcet &source = symex_targett::sourcet())
+{
+  eq.assertion(gen_true_expr(), cond, "", {}, source, 0);
+}
+
+void assume(symex_target_equationt &eq, const expr2tc &cond)
+{
+  eq.assumption(gen_true_expr(), cond, symex_targett::sourcet(), 0);
+}
+
+/// Level 2 name \n of the program variable \name
+expr2tc l2(const std::string &name, unsigned n, const type2tc &t = u32())
+{
+  return symbol2tc(t, name, symbol2t::level2, 1, n, 0, 0);
+}
+
+/// The steps that are not ignored
+symex_target_equationt::SSA_stepst
+kept(const symex_target_equationt::SSA_stepst &steps)
+{
+  symex_target_equationt::SSA_stepst result;
+  for (const auto &step : steps)
+    if (!step.ignore)
+      result.push_back(step);
+  return result;
+}
+
+bool same_steps(
+  const symex_target_equationt::SSA_stepst &a,
+  const symex_target_equationt::SSA_stepst &b)
+{
+  if (a.size() != b.size())
+    return false;
+
+  for (size_t i = 0; i < a.size(); i++)
+    if (
+      a[i].type != b[i].type || a[i].guard != b[i].guard ||
+      a[i].lhs != b[i].lhs || a[i].rhs != b[i].rhs || a[i].cond != b[i].cond)
+      return false;
+  return true;
+}
+
+/// The \i-th assertion of \steps, counting from 1 as claim numbers do
+symex_target_equationt::SSA_stepst::const_iterator
+nth_claim(const symex_target_equationt::SSA_stepst &steps, size_t i)
+{
+  for (auto it = steps.begin(); it != steps.end(); it++)
+    if (it->is_assert() && --i == 0)
+      return it;
+  return steps.end();
+}
+
+/**
+ * The symex slicer as it was before slice_dependency_grapht: dependencies
+ * are kept as symbol names, and every step is visited by get_symbols().
+ */
+class name_slicert
+{
+public:
+  explicit name_slicert(bool slice_assumes) : slice_assumes(slice_assumes)
+  {
+  }
+
+  void run(symex_target_equationt::SSA_stepst &steps)
+  {
+    for (auto it = steps.rbegin(); it != steps.rend(); it++)
+    {
+      if (it->ignore)
+        continue;
+      if (it->is_assert())
+        run_on_assert(*it);
+      else if (it->is_assume())
+        run_on_assume(*it);
+      else if (it->is_assignment())
+        run_on_assignment(*it);
+      else if (it->is_renumber())
+        run_on_renumber(*it);
+    }
+  }
+
+private:
+  const bool slice_assumes;
+  std::unordered_set<std::string> depends;
+  std::unordered_map<std::string, std::unordered_set<size_t>> indexes;
+
+  template <bool Add>
+  bool get_symbols(const expr2tc &expr)
+  {
+    bool res = false;
+    if (is_index2t(expr))
+    {
+      const index2t &index = to_index2t(expr);
+      if (
+        is_symbol2t(index.source_value) && is_constant_number(index.index) &&
+        !to_constant_int2t(index.index).value.is_negative())
+      {
+        const symbol2t &s = to_symbol2t(index.source_value);
+        const constant_int2t &i = to_constant_int2t(index.index);
+        if constexpr (Add)
+          return indexes[s.get_symbol_name()].insert(i.as_ulong()).second;
+      }
+    }
+
+    expr->foreach_operand([this, &res](const expr2tc &e) {
+      if (!is_nil_expr(e))
+        res |= get_symbols<Add>(e);
+    });
+
+    if (!is_symbol2t(expr))
+      return res;
+
+    const symbol2t &s = to_symbol2t(expr);
+    if constexpr (Add)
+      res |= depends.insert(s.get_symbol_name()).second;
+    else
+      res |= depends.count(s.get_symbol_name()) != 0;
+    return res;
+  }
+
+  void run_on_assert(symex_target_equationt::SSA_stept &step)
+  {
+    get_symbols<true>(step.guard);
+    get_symbols<true>(step.cond);
+  }
+
+  void run_on_assume(symex_target_equationt::SSA_stept &step)
+  {
+    if (slice_assumes && !get_symbols<false>(step.cond))
+    {
+      step.ignore = true;
+      return;
+    }
+    get_symbols<true>(step.guard);
+    get_symbols<true>(step.cond);
+  }
+
+  void run_on_assignment(symex_target_equationt::SSA_stept &step)
+  {
+    if (get_symbols<false>(step.lhs))
+    {
+      get_symbols<true>(step.guard);
+      get_symbols<true>(step.rhs);
+      depends.erase(to_symbol2t(step.lhs).get_symbol_name());
+      return;
+    }
+
+    auto it = indexes.find(to_symbol2t(step.lhs).get_symbol_name());
+    if (
+      is_with2t(step.rhs) && is_symbol2t(to_with2t(step.rhs).source_value) &&
+      is_constant_int2t(to_with2t(step.rhs).update_field) &&
+      !to_constant_int2t(to_with2t(step.rhs).update_field).value.is_negative())
+    {
+      const with2t &with = to_with2t(step.rhs);
+      const std::string source =
+        to_symbol2t(with.source_value).get_symbol_name();
+      size_t index = to_constant_int2t(with.update_field).as_ulong();
+      if (it != indexes.end())
+      {
+        get_symbols<true>(step.guard);
+        std::unordered_set<size_t> watched = it->second;
+        if (watched.erase(index))
+          get_symbols<true>(with.update_value);
+        else
+          step.cond = equality2tc(step.lhs, with.source_value);
+        indexes[source] = watched;
+        return;
+      }
+    }
+
+    if (it != indexes.end())
+    {
+      get_symbols<true>(step.guard);
+      get_symbols<true>(step.rhs);
+      return;
+    }
+
+    step.ignore = true;
+  }
+
+  void run_on_renumber(symex_target_equationt::SSA_stept &step)
+  {
+    if (!get_symbols<false>(step.lhs))
+      step.ignore = true;
+  }
+};
+
+/// Random formulas over a few program variables at different levels
+class random_equationt
+{
+public:
+  explicit random_equationt(unsigned seed)
+    : rng(seed), arr_t(array_type2tc(u32(), num(3), false))
+  {
+  }
+
+  void fill(symex_target_equationt &eq, size_t num_steps)
+  {
+    for (size_t i = 0; i < num_steps; i++)
+    {
+      switch (rng() % 6)
+      {
+      case 0:
+        check(eq, boolean());
+        break;
+      case 1:
+        assume(eq, boolean());
+        break;
+      case 2:
+        eq.renumber(guard(), scalar_symbol(), num(1), symex_targett::sourcet());
+        break;
+      case 3:
+        eq.assignment(
+          guard(),
+          array_symbol(),
+          expr2tc(),
+          array(),
+          expr2tc(),
+          symex_targett::sourcet(),
+          {},
+          false,
+          0);
+        break;
+      default:
+        eq.assignment(
+          guard(),
+          scalar_symbol(),
+          expr2tc(),
+          scalar(2),
+          expr2tc(),
+          symex_targett::sourcet(),
+          {},
+          false,
+          0);
+        break;
+      }
+      eq.SSA_steps.back().ignore = rng() % 8 == 0;
+    }
+  }
+
+private:
+  std::mt19937 rng;
+  type2tc arr_t;
+
+  /// The same variable at the levels that print as the same name or not
+  expr2tc scalar_symbol()
+  {
+    switch (rng() % 5)
+    {
+    case 0:
+      return symbol2tc(u32(), "g");
+    case 1:
+      return symbol2tc(u32(), "g", symbol2t::level1_global);
+    case 2:
+      return symbol2tc(
+        u32(), "g", symbol2t::level2_global, 0, rng() % 3, 0, rng() % 2);
+    case 3:
+      return symbol2tc(u32(), "x", symbol2t::level1, rng() % 2, 0, rng() % 2);
+    default:
+      return symbol2tc(
+        u32(),
+        rng() % 2 ? "x" : "y",
+        symbol2t::level2,
+        rng() % 2,
+        rng() % 3,
+        rng() % 2,
+        rng() % 2);
+    }
+  }
+
+  expr2tc array_symbol()
+  {
+    return symbol2tc(arr_t, "arr", symbol2t::level2, 1, rng() % 4, 0, 0);
+  }
+
+  expr2tc index()
+  {
+    return rng() % 4 ? num(rng() % 3) : scalar_symbol();
+  }
+
+  expr2tc scalar(unsigned depth)
+  {
+    switch (depth ? rng() % 4 : rng() % 2)
+    {
+    case 0:
+      return scalar_symbol();
+    case 1:
+      return num(rng() % 4);
+    case 2:
+      return index2tc(u32(), array_symbol(), index());
+    default:
+      return add2tc(u32(), scalar(depth - 1), scalar(depth - 1));
+    }
+  }
+
+  expr2tc array()
+  {
+    if (rng() % 4 == 0)
+      return array_symbol();
+    return with2tc(arr_t, array_symbol(), index(), scalar(1));
+  }
+
+  expr2tc boolean()
+  {
+    return equality2tc(scalar(1), scalar(1));
+  }
+
+  expr2tc guard()
+  {
+    return rng() % 2 ? gen_true_expr() : boolean();
+  }
+};
+} // namespace
+
+TEST_CASE(
+  "The size of a claim is the size of its sliced formula",
+  "[core][goto-symex][slice]")
+{
+  contextt ctx;
+  namespacet ns(ctx);
+  symex_target_equationt eq(ns);
+  optionst options;
+
+  // The first claim depends on two assignments, the second one on one
+  assign(eq, sym("a"), add2tc(u32(), sym("x"), num(1)));
+  assign(eq, sym("b"), mul2tc(u32(), sym("a"), num(2)));
+  check(eq, equality2tc(sym("b"), num(4)));
+  assign(eq, sym("c"), num(5));
+  check(eq, equality2tc(sym("c"), num(5)));
+
+  slice_dependency_grapht graph(eq.SSA_steps);
+  symex_slicet slicer(options);
+  const size_t first =
+    slicer.claim_size(graph, eq.SSA_steps, nth_claim(eq.SSA_steps, 1));
+  const size_t second =
+    slicer.claim_size(graph, eq.SSA_steps, nth_claim(eq.SSA_steps, 2));
+
+  // The later claim is cheaper, so bmct schedules it first
+  REQUIRE(first == 3);
+  REQUIRE(second == 2);
+
+  symex_target_equationt::SSA_stepst sliced;
+  slicer.run_on_claim(
+    graph, eq.SSA_steps, nth_claim(eq.SSA_steps, 2), sliced);
+  REQUIRE(sliced.size() == second);
+}
+
+TEST_CASE(
+  "Slicing a claim from the shared equation matches slicing a copy",
+  "[core][goto-symex][slice]")
+{
+  contextt ctx;
+  namespacet ns(ctx);
+  symex_target_equationt eq(ns);
+  optionst options;
+  options.set_option("slice-assumes", GENERATE(false, true));
+
+  // claim_slicer reads the claim's guard and location from the program
+  goto_programt prog;
+  goto_programt::targett assert_insn = prog.add_instruction(ASSERT);
+  assert_insn->guard = gen_true_expr();
+  const symex_targett::sourcet source(assert_insn, &prog);
+
+  type2tc arr_t = array_type2tc(u32(), num(4), false);
+  assign(eq, l2("x", 1), add2tc(u32(), sym("n"), num(1)));
+  assume(eq, greaterthan2tc(l2("x", 1), num(0)));
+  assign(eq, l2("y", 1), num(7));
+  expr2tc arr0 = l2("arr", 0, arr_t);
+  expr2tc arr1 = l2("arr", 1, arr_t);
+  expr2tc arr2 = l2("arr", 2, arr_t);
+  assign(eq, arr1, with2tc(arr_t, arr0, num(0), l2("x", 1)));
+  assign(eq, arr2, with2tc(arr_t, arr1, num(1), l2("y", 1)));
+  check(eq, equality2tc(index2tc(u32(), arr2, num(0)), l2("x", 1)), source);
+  assign(eq, l2("z", 1), mul2tc(u32(), l2("y", 1), num(2)));
+  assign(eq, l2("w", 1), num(3));
+  eq.SSA_steps.back().ignore = true;
+  assume(eq, equality2tc(l2("w", 1), num(3)));
+  check(eq, equality2tc(l2("z", 1), num(14)), source);
+  assume(eq, notequal2tc(l2("x", 1), l2("z", 1)));
+  check(eq, notequal2tc(l2("x", 1), num(0)), source);
+
+  slice_dependency_grapht graph(eq.SSA_steps);
+  for (size_t i = 1; i <= 3; i++)
+  {
+    auto claim = nth_claim(eq.SSA_steps, i);
+    symex_target_equationt::SSA_stepst sliced;
+    symex_slicet(options).run_on_claim(graph, eq.SSA_steps, claim, sliced);
+
+    /* What multi_property_check used to do on a copy of the equation. The
+     * steps after the claim can't influence it and run_on_claim never
+     * looks at them, so they are dropped from the copy as well. */
+    symex_target_equationt::SSA_stepst copy(
+      eq.SSA_steps.cbegin(), std::next(claim));
+    claim_slicer(i, false, false, ns).run(copy);
+    symex_slicet(options).run(copy);
+
+    REQUIRE(!sliced.empty());
+    REQUIRE(same_steps(sliced, kept(copy)));
+  }
+}
+
+TEST_CASE(
+  "Slicing on symbol ids matches slicing on symbol names",
+  "[core][goto-symex][slice]")
+{
+  contextt ctx;
+  namespacet ns(ctx);
+  const bool slice_assumes = GENERATE(false, true);
+  optionst options;
+  options.set_option("slice-assumes", slice_assumes);
+
+  for (unsigned seed = 0; seed < 500; seed++)
+  {
+    symex_target_equationt eq(ns);
+    random_equationt(seed).fill(eq, 16);
+
+    symex_target_equationt::SSA_stepst by_id = eq.SSA_steps;
+    symex_slicet(options).run(by_id);
+    symex_target_equationt::SSA_stepst by_name = eq.SSA_steps;
+    name_slicert(slice_assumes).run(by_name);
+
+    for (size_t i = 0; i < by_id.size(); i++)
+    {
+      INFO("seed " << seed << ", step " << i);
+      REQUIRE(by_id[i].ignore == by_name[i].ignore);
+      REQUIRE(by_id[i].cond == by_name[i].cond);
+    }
+  }
+}
@@ -0,0 +1,68 @@
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <goto-symex/symex_target_equation.h>
+#include <irep2/irep2_utils.h>
+
+namespace
+{
+expr2tc x_plus_1()
+{
+  type2tc t = get_uint_type(32);
+  return add2tc(t, symbol2tc(t, "x"), constant_int2tc(t, BigInt(1)));
+}
+
+void assign(symex_target_equationt &eq, const expr2tc &lhs, const expr2tc &rhs)
+{
+  eq.assignment(
+    gen_true_expr(),
+    lhs,
+    lhs,
+    rhs,
+    rhs,
+    symex_targett::sourcet(),
+    {},
+    false,
+    0);
+}
+} // namespace
+
+TEST_CASE(
+  "Equal subexpressions of different assignments share one node",
+  "[core][goto-symex][symex_target_equation]")
+{
+  contextt ctx;
+  namespacet ns(ctx);
+  symex_target_equationt eq(ns);
+  type2tc t = get_uint_type(32);
+
+  // Both right-hand sides are built separately
+  assign(eq, symbol2tc(t, "a"), mul2tc(t, x_plus_1(), symbol2tc(t, "y")));
+  assign(eq, symbol2tc(t, "b"), sub2tc(t, symbol2tc(t, "z"), x_plus_1()));
+
+  const expr2tc &first = to_mul2t(eq.SSA_steps[0].rhs).side_1;
+  const expr2tc &second = to_sub2t(eq.SSA_steps[1].rhs).side_2;
+  REQUIRE(first == second);
+  REQUIRE(first.get() == second.get());
+}
+
+TEST_CASE(
+  "Clones and cleared equations don't share with past assignments",
+  "[core][goto-symex][symex_target_equation]")
+{
+  contextt ctx;
+  namespacet ns(ctx);
+  symex_target_equationt eq(ns);
+  type2tc t = get_uint_type(32);
+
+  assign(eq, symbol2tc(t, "a"), x_plus_1());
+  const expr2tc old = eq.SSA_steps[0].rhs;
+
+  auto clone = std::static_pointer_cast<symex_target_equationt>(eq.clone());
+  assign(*clone, symbol2tc(t, "b"), x_plus_1());
+  REQUIRE(clone->SSA_steps[1].rhs == old);
+  REQUIRE(clone->SSA_steps[1].rhs.get() != old.get());
+
+  eq.clear();
+  assign(eq, symbol2tc(t, "b"), x_plus_1());
+  REQUIRE(eq.SSA_steps[0].rhs.get() != old.get());
+}
@@ -3,6 +3,7 @@
 #include <irep2/irep2.h>
 #include <irep2/irep2_utils.h>
 #include <util/crypto_hash.h>
+#include <thread>
 
 namespace
 {
@@ -115,3 +116,44 @@ SCENARIO("irep2 hashing", "[core][irep2]")
     }
   }
 }
+
+SCENARIO("irep2 cached crc", "[core][irep2]")
+{
+  GIVEN("An expression whose crc was computed")
+  {
+    expr2tc e = gen_testing_struct(1, 2);
+    size_t crc = e.crc();
+
+    THEN("Copies keep the same crc")
+    {
+      expr2tc copy = e->clone();
+      REQUIRE(copy->crc_val == crc);
+      REQUIRE(copy.crc() == crc);
+    }
+    THEN("Changing the expression recomputes it")
+    {
+      expr2tc copy = e;
+      to_constant_struct2t(copy).datatype_members[0] = gen_ulong(3);
+      REQUIRE(copy.crc() == gen_testing_struct(3, 2).crc());
+      REQUIRE(copy.crc() != crc);
+      REQUIRE(e.crc() == crc);
+    }
+  }
+  GIVEN("An expression shared between threads")
+  {
+    expr2tc e = gen_testing_struct(4, 5);
+    size_t expected = gen_testing_struct(4, 5).crc();
+
+    THEN("All threads see the same crc")
+    {
+      std::vector<size_t> seen(8);
+      std::vector<std::thread> threads;
+      for (size_t i = 0; i < seen.size(); i++)
+        threads.emplace_back([&e, &seen, i]() { seen[i] = e.crc(); });
+      for (auto &t : threads)
+        t.join();
+      for (size_t crc : seen)
+        REQUIRE(crc == expected);
+    }
+  }
+}
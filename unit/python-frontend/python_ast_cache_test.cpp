@@ -0,0 +1,128 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <python-frontend/python_ast_cache.h>
+#include <util/filesystem.h>
+
+#include <fstream>
+#include <sstream>
+
+#include <boost/filesystem.hpp>
+#include <nlohmann/json.hpp>
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+void write(const fs::path &path, const std::string &contents)
+{
+  std::ofstream(path.string()) << contents;
+}
+
+std::string read(const fs::path &path)
+{
+  std::ifstream in(path.string());
+  std::ostringstream buf;
+  buf << in.rdbuf();
+  return buf.str();
+}
+
+/// A module AST as parser.py writes it into \out
+void write_ast(const fs::path &out, const std::string &module, const fs::path &file)
+{
+  nlohmann::json ast = {{"filename", file.string()}, {"body", nlohmann::json::array()}};
+  write(out / (module + ".json"), ast.dump());
+}
+
+/// A script main.py importing other.py, both in a temporary directory
+struct scriptt
+{
+  file_operations::tmp_path dir =
+    file_operations::create_tmp_dir("esbmc-python-script-%%%%-%%%%");
+  file_operations::tmp_path cache_dir =
+    file_operations::create_tmp_dir("esbmc-python-cache-%%%%-%%%%");
+  fs::path main = fs::path(dir.path()) / "main.py";
+  fs::path other = fs::path(dir.path()) / "other.py";
+
+  scriptt()
+  {
+    write(main, "import other\n");
+    write(other, "def f() -> int:\n    return 1\n");
+  }
+
+  python_ast_cachet cache(const std::string &script) const
+  {
+    return python_ast_cachet(cache_dir.path(), script, "parser", "python3");
+  }
+
+  /// What parser.py would write for \script
+  void parse(const std::string &script, const std::string &out) const
+  {
+    write_ast(out, "main", script);
+    write_ast(out, "other", other);
+  }
+};
+} // namespace
+
+TEST_CASE("A stored AST is reused", "[python][ast_cache]")
+{
+  scriptt s;
+  auto first = file_operations::create_tmp_dir("esbmc-python-ast-%%%%-%%%%");
+  s.parse(s.main.string(), first.path());
+  s.cache(s.main.string()).store(first.path());
+
+  auto second = file_operations::create_tmp_dir("esbmc-python-ast-%%%%-%%%%");
+  REQUIRE(s.cache(s.main.string()).load(second.path()));
+  REQUIRE(
+    read(fs::path(second.path()) / "other.json") ==
+    read(fs::path(first.path()) / "other.json"));
+}
+
+TEST_CASE("Editing an imported module invalidates the AST", "[python][ast_cache]")
+{
+  scriptt s;
+  auto out = file_operations::create_tmp_dir("esbmc-python-ast-%%%%-%%%%");
+  s.parse(s.main.string(), out.path());
+  s.cache(s.main.string()).store(out.path());
+
+  write(s.other, "def f() -> int:\n    return 2\n");
+  auto next = file_operations::create_tmp_dir("esbmc-python-ast-%%%%-%%%%");
+  REQUIRE(!s.cache(s.main.string()).load(next.path()));
+}
+
+TEST_CASE("Editing the script invalidates the AST", "[python][ast_cache]")
+{
+  scriptt s;
+  auto out = file_operations::create_tmp_dir("esbmc-python-ast-%%%%-%%%%");
+  s.parse(s.main.string(), out.path());
+  s.cache(s.main.string()).store(out.path());
+
+  write(s.main, "import other\nother.f()\n");
+  auto next = file_operations::create_tmp_dir("esbmc-python-ast-%%%%-%%%%");
+  REQUIRE(!s.cache(s.main.string()).load(next.path()));
+}
+
+TEST_CASE(
+  "A relative path names a different script in another directory",
+  "[python][ast_cache]")
+{
+  scriptt a;
+  scriptt b;
+  const fs::path cwd = fs::current_path();
+
+  // Both scripts are run as "main.py", from their own directory
+  fs::current_path(a.dir.path());
+  auto out = file_operations::create_tmp_dir("esbmc-python-ast-%%%%-%%%%");
+  a.parse("main.py", out.path());
+  a.cache("main.py").store(out.path());
+
+  fs::current_path(b.dir.path());
+  auto next = file_operations::create_tmp_dir("esbmc-python-ast-%%%%-%%%%");
+  const bool loaded =
+    python_ast_cachet(a.cache_dir.path(), "main.py", "parser", "python3")
+      .load(next.path());
+  fs::current_path(cwd);
+
+  // b's main.py imports b's other.py, not the one recorded for a
+  REQUIRE(!loaded);
+}
@@ -0,0 +1,175 @@
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <solvers/sat/cnf_conv.h>
+
+#include <functional>
+#include <random>
+
+namespace
+{
+/// Records the clauses cnf_convt produces instead of solving them
+class cnf_recordert : public cnf_iface, public cnf_convt
+{
+public:
+  cnf_recordert() : cnf_convt(static_cast<cnf_iface *>(this))
+  {
+  }
+
+  void setto(literalt a, bool val) override
+  {
+    lcnf({val ? a : cnf_convt::lnot(a)});
+  }
+
+  void lcnf(const bvt &bv) override
+  {
+    clauses.push_back(bv);
+  }
+
+  void assert_lit(const literalt &a) override
+  {
+    lcnf({a});
+  }
+
+  tvt l_get(const literalt &) override
+  {
+    return tvt(tvt::TV_UNKNOWN);
+  }
+
+  literalt new_variable() override
+  {
+    return literalt(num_vars++, false);
+  }
+
+  std::vector<bvt> clauses;
+  unsigned num_vars = 0;
+};
+
+typedef std::function<bool(unsigned)> boolean_functiont;
+} // namespace
+
+TEST_CASE("Equal gates are encoded once", "[solvers][sat][cnf_conv]")
+{
+  cnf_recordert cnf;
+  literalt a = cnf.new_variable();
+  literalt b = cnf.new_variable();
+
+  literalt g = cnf.land(a, b);
+  const size_t num_clauses = cnf.clauses.size();
+  REQUIRE(cnf.land(b, a) == g);
+  REQUIRE(cnf.lor(cnf.lnot(a), cnf.lnot(b)) == cnf.lnot(g));
+  REQUIRE(cnf.lxor(a, b) == cnf.lxor(cnf.lnot(b), cnf.lnot(a)));
+  REQUIRE(cnf.lxor(cnf.lnot(a), b) == cnf.lnot(cnf.lxor(a, b)));
+  REQUIRE(cnf.land(a, cnf.lnot(a)) == const_literal(false));
+  REQUIRE(cnf.land(g, a) == g);
+  REQUIRE(cnf.lselect(a, b, b) == b);
+
+  // Only the xor gate is new
+  REQUIRE(cnf.clauses.size() == num_clauses + 4);
+}
+
+TEST_CASE(
+  "Random gate networks are encoded faithfully",
+  "[solvers][sat][cnf_conv]")
+{
+  /* Builds random networks of gates over a few inputs, with each gate's
+   * boolean function alongside. For every assignment of the inputs, the
+   * clauses must have exactly one model, which gives every literal the
+   * value of its function. */
+  const unsigned num_inputs = 4;
+  const unsigned num_gates = 12;
+  std::mt19937 rng(1);
+
+  for (int round = 0; round < 2000; round++)
+  {
+    cnf_recordert cnf;
+    std::vector<literalt> lits;
+    std::vector<boolean_functiont> funcs;
+    for (unsigned i = 0; i < num_inputs; i++)
+    {
+      lits.push_back(cnf.new_variable());
+      funcs.push_back([i](unsigned m) { return (m >> i) & 1; });
+    }
+    lits.push_back(const_literal(true));
+    funcs.push_back([](unsigned) { return true; });
+    lits.push_back(const_literal(false));
+    funcs.push_back([](unsigned) { return false; });
+
+    auto pick = [&]() {
+      size_t i = rng() % lits.size();
+      bool neg = rng() & 1;
+      boolean_functiont f = funcs[i];
+      return std::make_pair(
+        neg ? cnf.lnot(lits[i]) : lits[i],
+        boolean_functiont([f, neg](unsigned m) { return f(m) != neg; }));
+    };
+
+    for (unsigned k = 0; k < num_gates; k++)
+    {
+      auto [a, fa] = pick();
+      auto [b, fb] = pick();
+      auto [c, fc] = pick();
+      switch (rng() % 5)
+      {
+      case 0:
+        lits.push_back(cnf.land(a, b));
+        funcs.push_back([=](unsigned m) { return fa(m) && fb(m); });
+        break;
+      case 1:
+        lits.push_back(cnf.lor(a, b));
+        funcs.push_back([=](unsigned m) { return fa(m) || fb(m); });
+        break;
+      case 2:
+        lits.push_back(cnf.lxor(a, b));
+        funcs.push_back([=](unsigned m) { return fa(m) != fb(m); });
+        break;
+      case 3:
+        lits.push_back(cnf.lselect(a, b, c));
+        funcs.push_back([=](unsigned m) { return fa(m) ? fb(m) : fc(m); });
+        break;
+      default:
+        lits.push_back(cnf.lequal(a, b));
+        funcs.push_back([=](unsigned m) { return fa(m) == fb(m); });
+        break;
+      }
+    }
+
+    // Keep the enumeration of the gate variables small
+    const unsigned num_gate_vars = cnf.num_vars - num_inputs;
+    if (num_gate_vars > 16)
+      continue;
+
+    for (unsigned m = 0; m < (1u << num_inputs); m++)
+    {
+      unsigned num_models = 0;
+      for (unsigned g = 0; g < (1u << num_gate_vars); g++)
+      {
+        const unsigned model = m | (g << num_inputs);
+        auto value = [model](literalt l) {
+          if (l.is_constant())
+            return l.is_true();
+          return bool((model >> l.var_no()) & 1) != l.sign();
+        };
+
+        bool sat = true;
+        for (const bvt &clause : cnf.clauses)
+        {
+          bool clause_sat = false;
+          for (literalt l : clause)
+            clause_sat |= value(l);
+          if (!clause_sat)
+          {
+            sat = false;
+            break;
+          }
+        }
+        if (!sat)
+          continue;
+
+        num_models++;
+        for (size_t i = 0; i < lits.size(); i++)
+          REQUIRE(value(lits[i]) == funcs[i](m));
+      }
+      REQUIRE(num_models == 1);
+    }
+  }
+}
@@ -0,0 +1,112 @@
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <solvers/dimacs/dimacs_solver.h>
+#include <util/filesystem.h>
+
+#include <cstring>
+#include <string>
+
+namespace
+{
+/// A solver binary that runs \script with the DIMACS file as its argument
+class stub_solvert
+{
+public:
+  explicit stub_solvert(const std::string &script)
+    : file(file_operations::create_tmp_file("esbmc-stub.%%%%-%%%%.sh"))
+  {
+    fputs(script.c_str(), file.file());
+    fflush(file.file());
+  }
+
+  std::string command()
+  {
+    return "sh '" + file.path() + "'";
+  }
+
+private:
+  file_operations::tmp_file file;
+};
+
+std::string dimacs(const dimacs_solvert &solver)
+{
+  char *buf = nullptr;
+  size_t size = 0;
+  FILE *out = open_memstream(&buf, &size);
+  solver.write(out);
+  fclose(out);
+  std::string text(buf, size);
+  free(buf);
+  return text;
+}
+} // namespace
+
+TEST_CASE(
+  "Clauses and assumptions are written in DIMACS",
+  "[solvers][dimacs]")
+{
+  dimacs_solvert solver("true");
+  for (int lit : {1, -2, 0, 2, 3, 0})
+    solver.add(lit);
+  solver.assume(-4);
+
+  REQUIRE(dimacs(solver) == "p cnf 4 3\n1 -2 0\n2 3 0\n-4 0\n");
+}
+
+TEST_CASE("The model is read from the v lines", "[solvers][dimacs]")
+{
+  stub_solvert stub("echo 's SATISFIABLE'\necho 'v 1 -2'\necho 'v 4 0'\n");
+  dimacs_solvert solver(stub.command());
+  for (int lit : {1, -2, 0, 4, 0})
+    solver.add(lit);
+
+  REQUIRE(solver.solve() == 10);
+  REQUIRE(solver.val(1) == 1);
+  REQUIRE(solver.val(-1) == 1);
+  REQUIRE(solver.val(2) == -2);
+  REQUIRE(solver.val(-2) == -2);
+  REQUIRE(solver.val(4) == 4);
+  // Variables the model doesn't list have no value
+  REQUIRE(solver.val(3) == 0);
+}
+
+TEST_CASE(
+  "Assumptions are only passed to the next solve",
+  "[solvers][dimacs]")
+{
+  // Unsatisfiable whenever the file has the unit clause "-1 0"
+  stub_solvert stub(
+    "if grep -q '^-1 0$' \"$1\"; then echo 's UNSATISFIABLE'; "
+    "else echo 's SATISFIABLE'; echo 'v 1 0'; fi\n");
+  dimacs_solvert solver(stub.command());
+  solver.add(1);
+  solver.add(0);
+
+  solver.assume(-1);
+  REQUIRE(solver.solve() == 20);
+  REQUIRE(solver.solve() == 10);
+  REQUIRE(solver.val(1) == 1);
+}
+
+TEST_CASE(
+  "The exit code is the answer when there is no status line",
+  "[solvers][dimacs]")
+{
+  stub_solvert unsat("exit 20\n");
+  dimacs_solvert solver(unsat.command());
+  REQUIRE(solver.solve() == 20);
+
+  stub_solvert silent("exit 0\n");
+  dimacs_solvert unknown(silent.command());
+  REQUIRE(unknown.solve() == 0);
+}
+
+TEST_CASE("A terminated solver gives no answer", "[solvers][dimacs]")
+{
+  stub_solvert stub("echo 's SATISFIABLE'\n");
+  dimacs_solvert solver(stub.command());
+  solver.terminate();
+  REQUIRE(solver.solve() == 0);
+  // Only the next solve() is affected
+  REQUIRE(solver.solve() == 10);
+}
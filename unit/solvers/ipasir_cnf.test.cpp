@@ -0,0 +1,142 @@
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <solvers/dimacs/dimacs_solver.h>
+#include <solvers/dimacs/ipasir_cnf.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+/// An IPASIR solver that tries every assignment, for small formulas
+class brute_force_solvert : public ipasir_iface
+{
+public:
+  const char *signature() const override
+  {
+    return "brute force";
+  }
+
+  void add(int lit) override
+  {
+    if (lit == 0)
+    {
+      clauses.push_back(clause);
+      clause.clear();
+      return;
+    }
+    clause.push_back(lit);
+    num_vars = std::max(num_vars, std::abs(lit));
+  }
+
+  void assume(int lit) override
+  {
+    clauses.push_back({lit});
+    num_vars = std::max(num_vars, std::abs(lit));
+  }
+
+  int solve() override
+  {
+    for (unsigned m = 0; m < (1u << num_vars); m++)
+    {
+      model = m;
+      bool sat = true;
+      for (const std::vector<int> &c : clauses)
+      {
+        bool clause_sat = false;
+        for (int lit : c)
+          clause_sat |= val(lit) == lit;
+        sat &= clause_sat;
+      }
+      if (sat)
+        return 10;
+    }
+    return 20;
+  }
+
+  int val(int lit) const override
+  {
+    bool value = (model >> (std::abs(lit) - 1)) & 1;
+    return value == (lit > 0) ? lit : -lit;
+  }
+
+  void terminate() override
+  {
+  }
+
+  std::vector<std::vector<int>> clauses;
+
+private:
+  std::vector<int> clause;
+  int num_vars = 0;
+  unsigned model = 0;
+};
+} // namespace
+
+TEST_CASE(
+  "Gates encoded through IPASIR have a consistent model",
+  "[solvers][dimacs][ipasir_cnf]")
+{
+  brute_force_solvert solver;
+  ipasir_cnft cnf(solver);
+  literalt a = cnf.new_variable();
+  literalt b = cnf.new_variable();
+  literalt c = cnf.new_variable();
+
+  // (a xor b) and (a or c), with a and not c
+  literalt x = cnf.lxor(a, b);
+  literalt f = cnf.land(x, cnf.lor(a, c));
+  cnf.assert_lit(f);
+  cnf.setto(a, true);
+  cnf.setto(c, false);
+
+  REQUIRE(cnf.solve() == 10);
+  REQUIRE(cnf.l_get(a).is_true());
+  REQUIRE(cnf.l_get(b).is_false());
+  REQUIRE(cnf.l_get(c).is_false());
+  REQUIRE(cnf.l_get(x).is_true());
+  REQUIRE(cnf.l_get(const_literal(true)).is_true());
+}
+
+TEST_CASE(
+  "Contradictions are unsatisfiable through IPASIR",
+  "[solvers][dimacs][ipasir_cnf]")
+{
+  brute_force_solvert solver;
+  ipasir_cnft cnf(solver);
+  literalt a = cnf.new_variable();
+  literalt b = cnf.new_variable();
+
+  cnf.assert_lit(cnf.lequal(a, b));
+  cnf.assert_lit(cnf.lxor(a, b));
+  REQUIRE(cnf.solve() == 20);
+
+  // An empty clause never reaches the solver
+  brute_force_solvert other;
+  ipasir_cnft empty(other);
+  empty.assert_lit(const_literal(false));
+  REQUIRE(other.clauses.empty());
+  REQUIRE(empty.solve() == 20);
+}
+
+TEST_CASE(
+  "Clauses reach a DIMACS solver with variables numbered from 1",
+  "[solvers][dimacs][ipasir_cnf]")
+{
+  dimacs_solvert solver("true");
+  ipasir_cnft cnf(solver);
+  literalt a = cnf.new_variable();
+  literalt b = cnf.new_variable();
+  cnf.lcnf({a, cnf.lnot(b), const_literal(false)});
+  // Satisfied by the constant, dropped
+  cnf.lcnf({b, const_literal(true)});
+
+  char *buf = nullptr;
+  size_t size = 0;
+  FILE *out = open_memstream(&buf, &size);
+  solver.write(out);
+  fclose(out);
+  REQUIRE(std::string(buf, size) == "p cnf 2 1\n1 -2 0\n");
+  free(buf);
+}
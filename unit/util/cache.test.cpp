@@ -0,0 +1,98 @@
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <util/cache.h>
+#include <util/filesystem.h>
+#include <irep2/irep2_utils.h>
+
+namespace
+{
+expr2tc sym(const std::string &name)
+{
+  return symbol2tc(get_uint_type(32), name);
+}
+
+expr2tc num(unsigned n)
+{
+  return constant_int2tc(get_uint_type(32), BigInt(n));
+}
+
+/// x = 1; assert(x == n)
+symex_target_equationt::SSA_stepst equation(unsigned n)
+{
+  contextt ctx;
+  namespacet ns(ctx);
+  symex_target_equationt eq(ns);
+  eq.assignment(
+    gen_true_expr(),
+    sym("x"),
+    sym("x"),
+    num(1),
+    num(1),
+    symex_targett::sourcet(),
+    {},
+    false,
+    0);
+  eq.assertion(
+    gen_true_expr(),
+    equality2tc(sym("x"), num(n)),
+    "",
+    {},
+    symex_targett::sourcet(),
+    0);
+  return eq.SSA_steps;
+}
+
+optionst options(unsigned unwind)
+{
+  optionst opts;
+  opts.set_option("unwind", std::to_string(unwind));
+  opts.set_option("verbosity", "status");
+  return opts;
+}
+} // namespace
+
+TEST_CASE(
+  "A result cache key identifies the formula and how it is checked",
+  "[util][cache]")
+{
+  const result_cache cache("", options(1), "1");
+  const std::string key = cache.key(equation(1));
+
+  REQUIRE(result_cache("", options(1), "1").key(equation(1)) == key);
+
+  // Changing a step changes the formula
+  REQUIRE(cache.key(equation(2)) != key);
+
+  // Ignored steps are not part of the formula
+  auto ignored = equation(1);
+  ignored.insert(ignored.begin(), equation(2).back());
+  ignored.front().ignore = true;
+  REQUIRE(cache.key(ignored) == key);
+
+  // Options that change the result are part of the key, as is the version
+  REQUIRE(result_cache("", options(2), "1").key(equation(1)) != key);
+  REQUIRE(result_cache("", options(1), "2").key(equation(1)) != key);
+
+  // But not options that only change what is printed
+  optionst quiet = options(1);
+  quiet.set_option("verbosity", "error");
+  REQUIRE(result_cache("", quiet, "1").key(equation(1)) == key);
+}
+
+TEST_CASE("Only stored formulas are known to be UNSAT", "[util][cache]")
+{
+  auto dir = file_operations::create_tmp_dir("esbmc-result-cache-%%%%-%%%%");
+  const result_cache cache(dir.path(), options(1), "1");
+  const std::string unsat = cache.key(equation(1));
+  const std::string other = cache.key(equation(2));
+
+  REQUIRE(!cache.is_unsat(unsat));
+  cache.store_unsat(unsat);
+  REQUIRE(cache.is_unsat(unsat));
+  REQUIRE(!cache.is_unsat(other));
+
+  // Another run sharing the directory finds it too
+  REQUIRE(result_cache(dir.path(), options(1), "1").is_unsat(unsat));
+  REQUIRE(!result_cache(dir.path(), options(2), "1").is_unsat(
+    result_cache(dir.path(), options(2), "1").key(equation(1))));
+}
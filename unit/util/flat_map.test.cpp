@@ -0,0 +1,73 @@
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+
+#include <map>
+#include <util/flat_map.h>
+
+namespace
+{
+template <class Map>
+std::map<int, int> to_std_map(const Map &m)
+{
+  std::map<int, int> result;
+  for (const auto &[k, v] : m)
+    result.emplace(k, v);
+  return result;
+}
+} // namespace
+
+TEST_CASE("Entries are kept sorted", "[core][util][flat_map]")
+{
+  flat_mapt<int, int> m;
+  std::map<int, int> expected;
+  for (int i = 0; i < 100; i++)
+  {
+    m[(i * 37) % 101] = i;
+    expected[(i * 37) % 101] = i;
+  }
+  REQUIRE(m.size() == expected.size());
+  REQUIRE(to_std_map(m) == expected);
+
+  int last = -1;
+  for (auto it = m.begin(); it != m.end(); it++)
+  {
+    REQUIRE(it->first > last);
+    last = it->first;
+  }
+
+  REQUIRE(m.find(37)->second == 1);
+  REQUIRE(m.find(101) == m.end());
+  REQUIRE(m.erase(37) == 1);
+  REQUIRE(m.erase(37) == 0);
+  REQUIRE(m.count(37) == 0);
+}
+
+TEST_CASE("References survive insertions", "[core][util][flat_map]")
+{
+  flat_mapt<int, int> m;
+  int &first = m[50];
+  first = 1;
+  for (int i = 0; i < 100; i++)
+    m[i] += 0;
+  m.erase(49);
+  REQUIRE(&m[50] == &first);
+  REQUIRE(first == 1);
+}
+
+TEST_CASE("Copies are deep", "[core][util][flat_map]")
+{
+  flat_mapt<int, int> a;
+  a[1] = 1;
+  a[2] = 2;
+
+  flat_mapt<int, int> b = a;
+  REQUIRE(a == b);
+  b[1] = 10;
+  REQUIRE(a != b);
+  REQUIRE(a.find(1)->second == 1);
+
+  for (auto it = b.begin(); it != b.end(); it++)
+    it->second = 0;
+  REQUIRE(to_std_map(b) == std::map<int, int>{{1, 0}, {2, 0}});
+  REQUIRE(to_std_map(a) == std::map<int, int>{{1, 1}, {2, 2}});
+}
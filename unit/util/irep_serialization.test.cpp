@@ -0,0 +1,82 @@
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+
+#include <sstream>
+#include <util/irep_serialization.h>
+
+namespace
+{
+irept make_irep()
+{
+  irept leaf("leaf");
+  leaf.set("width", "32");
+
+  irept irep("node");
+  irep.get_sub().push_back(leaf);
+  irep.get_sub().push_back(leaf);
+  irep.add("operand") = leaf;
+  irep.set("#comment", "kept");
+  return irep;
+}
+} // namespace
+
+TEST_CASE("Sections round-trip", "[core][util][irep_serialization]")
+{
+  irep_string_tablet strings;
+  std::ostringstream section;
+  irep_section_serializationt(strings).write(section, make_irep());
+
+  std::ostringstream table;
+  strings.write(table);
+
+  std::istringstream table_in(table.str());
+  irep_string_tablet strings_in;
+  REQUIRE(!strings_in.read(table_in));
+
+  std::istringstream section_in(section.str());
+  irept irep;
+  irep_section_serializationt(strings_in).read(section_in, irep);
+  REQUIRE(full_eq(irep, make_irep()));
+  REQUIRE(section_in.peek() == EOF);
+}
+
+TEST_CASE("Equal ireps are written once", "[core][util][irep_serialization]")
+{
+  irep_string_tablet strings;
+  std::ostringstream once, twice;
+  irep_section_serializationt(strings).write(once, irept("leaf"));
+
+  irept irep("node");
+  irep.get_sub().push_back(irept("leaf"));
+  irep.get_sub().push_back(irept("leaf"));
+  irep_section_serializationt(strings).write(twice, irep);
+
+  // The second operand is only a reference to the first one
+  REQUIRE(twice.str().size() < 2 * once.str().size() + 5);
+}
+
+TEST_CASE("Varints round-trip", "[core][util][irep_serialization]")
+{
+  for (unsigned u : {0u, 1u, 127u, 128u, 300u, 0xffffffffu})
+  {
+    std::stringstream s;
+    irep_section_serializationt::write_varint(s, u);
+    REQUIRE(s.str().size() <= 5);
+    REQUIRE(irep_section_serializationt::read_varint(s) == u);
+  }
+}
+
+TEST_CASE("Truncated string tables", "[core][util][irep_serialization]")
+{
+  irep_string_tablet strings;
+  strings.add("first");
+  strings.add("second");
+  std::ostringstream table;
+  strings.write(table);
+
+  std::string truncated = table.str();
+  truncated.resize(truncated.size() - 3);
+  std::istringstream in(truncated);
+  irep_string_tablet strings_in;
+  REQUIRE(strings_in.read(in));
+}
@@ -0,0 +1,119 @@
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+
+#include <map>
+#include <util/persistent_map.h>
+
+namespace
+{
+// Puts every key in the same bucket to exercise the collision nodes
+struct bad_hash
+{
+  size_t operator()(int) const
+  {
+    return 42;
+  }
+};
+
+template <class Map>
+std::map<int, int> to_std_map(const Map &m)
+{
+  std::map<int, int> result;
+  for (const auto &[k, v] : m)
+    result.emplace(k, v);
+  return result;
+}
+} // namespace
+
+TEST_CASE(
+  "Entries can be inserted, found and erased",
+  "[core][util][persistent_map]")
+{
+  persistent_mapt<int, int> m;
+  std::map<int, int> expected;
+  for (int i = 0; i < 5000; i++)
+  {
+    m[i * 7] = i;
+    expected[i * 7] = i;
+  }
+  REQUIRE(m.size() == expected.size());
+  REQUIRE(to_std_map(m) == expected);
+  REQUIRE(m.find(21)->second == 3);
+  REQUIRE(m.find(22) == m.end());
+
+  for (int i = 0; i < 5000; i += 2)
+  {
+    REQUIRE(m.erase(i * 7) == 1);
+    expected.erase(i * 7);
+  }
+  REQUIRE(m.erase(0) == 0);
+  REQUIRE(m.size() == expected.size());
+  REQUIRE(to_std_map(m) == expected);
+
+  auto [value, inserted] = m.insert({7, 100});
+  REQUIRE(!inserted);
+  REQUIRE(*value == 1);
+}
+
+TEST_CASE(
+  "Copies don't see each other's changes",
+  "[core][util][persistent_map]")
+{
+  persistent_mapt<int, int> a;
+  for (int i = 0; i < 1000; i++)
+    a[i] = i;
+
+  persistent_mapt<int, int> b = a;
+  b[5] = 50;
+  b[2000] = 1;
+  b.erase(7);
+
+  REQUIRE(a.size() == 1000);
+  REQUIRE(a.find(5)->second == 5);
+  REQUIRE(a.count(2000) == 0);
+  REQUIRE(a.count(7) == 1);
+
+  REQUIRE(b.size() == 1000);
+  REQUIRE(b.find(5)->second == 50);
+  REQUIRE(b.count(7) == 0);
+}
+
+TEST_CASE("Differences skip what is shared", "[core][util][persistent_map]")
+{
+  persistent_mapt<int, int> a;
+  for (int i = 0; i < 1000; i++)
+    a[i] = i;
+
+  persistent_mapt<int, int> b = a;
+  b[5] = 50;
+  b[2000] = 1;
+  b.erase(7);
+
+  std::map<int, int> changed;
+  std::map<int, int> missing;
+  b.for_each_difference(a, [&](const auto &entry, const int *other) {
+    if (other == nullptr)
+      missing.emplace(entry.first, entry.second);
+    else if (*other != entry.second)
+      changed.emplace(entry.first, *other);
+  });
+
+  REQUIRE(changed == std::map<int, int>{{5, 5}});
+  REQUIRE(missing == std::map<int, int>{{2000, 1}});
+}
+
+TEST_CASE("Colliding hashes are kept apart", "[core][util][persistent_map]")
+{
+  persistent_mapt<int, int, bad_hash> m;
+  for (int i = 0; i < 10; i++)
+    m[i] = i * i;
+
+  persistent_mapt<int, int, bad_hash> copy = m;
+  copy.erase(3);
+
+  REQUIRE(m.size() == 10);
+  REQUIRE(m.find(3)->second == 9);
+  REQUIRE(copy.size() == 9);
+  REQUIRE(copy.find(3) == copy.end());
+  REQUIRE(copy.find(4)->second == 16);
+}
@@ -0,0 +1,60 @@
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <util/thread_pool.h>
+
+TEST_CASE("Every submitted task runs exactly once", "[core][util][thread_pool]")
+{
+  std::atomic<int> sum{0};
+  {
+    thread_poolt pool(4);
+    REQUIRE(pool.num_workers() == 4);
+    for (int i = 1; i <= 100; i++)
+      pool.submit([&sum, i]() { sum += i; });
+    pool.wait();
+  }
+  REQUIRE(sum == 5050);
+}
+
+TEST_CASE("No more tasks than workers run at once", "[core][util][thread_pool]")
+{
+  std::atomic<int> running{0};
+  std::atomic<int> max_running{0};
+  thread_poolt pool(2);
+  for (int i = 0; i < 16; i++)
+    pool.submit([&running, &max_running]() {
+      int now = ++running;
+      int seen = max_running;
+      while (now > seen && !max_running.compare_exchange_weak(seen, now))
+        ;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      --running;
+    });
+  pool.wait();
+  REQUIRE(max_running <= 2);
+}
+
+TEST_CASE("Tasks may submit more tasks", "[core][util][thread_pool]")
+{
+  std::atomic<int> count{0};
+  thread_poolt pool(3);
+  for (int i = 0; i < 10; i++)
+    pool.submit([&pool, &count]() {
+      ++count;
+      pool.submit([&count]() { ++count; });
+    });
+  pool.wait();
+  REQUIRE(count == 20);
+}
+
+TEST_CASE("Memory budget still makes progress", "[core][util][thread_pool]")
+{
+  // A budget of one byte is always exceeded, tasks must then run one by one
+  std::atomic<int> count{0};
+  thread_poolt pool(4, 1);
+  for (int i = 0; i < 8; i++)
+    pool.submit([&count]() { ++count; });
+  pool.wait();
+  REQUIRE(count == 8);
+}
@@ -0,0 +1,62 @@
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+
+#include <unordered_set>
+#include <util/zobrist_hash.h>
+
+TEST_CASE(
+  "Adding pairs in any order gives the same hash",
+  "[core][util][zobrist_hash]")
+{
+  zobrist_hasht a, b;
+  for (size_t i = 0; i < 100; i++)
+    a ^= zobrist_hasht::key(i, i * i);
+  for (size_t i = 100; i-- > 0;)
+    b ^= zobrist_hasht::key(i, i * i);
+  REQUIRE(a == b);
+  REQUIRE(a != zobrist_hasht());
+}
+
+TEST_CASE(
+  "Replacing a value and changing it back restores the hash",
+  "[core][util][zobrist_hash]")
+{
+  zobrist_hasht h;
+  h ^= zobrist_hasht::key(1, 10);
+  h ^= zobrist_hasht::key(2, 20);
+  const zobrist_hasht before = h;
+
+  h ^= zobrist_hasht::key(1, 10) ^ zobrist_hasht::key(1, 11);
+  REQUIRE(h != before);
+  h ^= zobrist_hasht::key(1, 11) ^ zobrist_hasht::key(1, 10);
+  REQUIRE(h == before);
+}
+
+TEST_CASE("Keys of different pairs differ", "[core][util][zobrist_hash]")
+{
+  std::unordered_set<zobrist_hasht, zobrist_hasht::hash> keys;
+  for (size_t a = 0; a < 64; a++)
+    for (size_t b = 0; b < 64; b++)
+      keys.insert(zobrist_hasht::key(a, b));
+  REQUIRE(keys.size() == 64 * 64);
+  REQUIRE(zobrist_hasht::key(1, 2) != zobrist_hasht::key(2, 1));
+}
+
+TEST_CASE(
+  "Keys of digests differing in any byte differ",
+  "[core][util][zobrist_hash]")
+{
+  std::unordered_set<zobrist_hasht, zobrist_hasht::hash> keys;
+  unsigned char digest[20] = {0};
+  keys.insert(zobrist_hasht::key(1, digest, sizeof(digest)));
+  for (size_t i = 0; i < sizeof(digest); i++)
+  {
+    digest[i] = 1;
+    keys.insert(zobrist_hasht::key(1, digest, sizeof(digest)));
+    digest[i] = 0;
+  }
+  REQUIRE(keys.size() == sizeof(digest) + 1);
+  REQUIRE(
+    zobrist_hasht::key(1, digest, sizeof(digest)) !=
+    zobrist_hasht::key(2, digest, sizeof(digest)));
+}